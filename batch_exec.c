@@ -0,0 +1,176 @@
+#include "main.h"
+
+/**
+ * argv_bytes - Measures what strings cost execve() against ARG_MAX.
+ * @strs: A NULL-terminated array of strings.
+ * @count: Number of strings to measure, or -1 for all of them.
+ *
+ * Return: The size of the strings, their '\0's and their pointers.
+ */
+size_t argv_bytes(char **strs, int count)
+{
+	size_t bytes = 0;
+	int index;
+
+	for (index = 0; strs[index] && index != count; index++)
+		bytes += _strlen(strs[index]) + 1 + sizeof(char *);
+	return (bytes);
+}
+
+/**
+ * run_batches - Runs a command whose arguments do not fit one execve().
+ * @info_struct: Pointer to the info structure.
+ *
+ * Description: argv and the environment are measured in the shell against
+ * sysconf(_SC_ARG_MAX), keeping 2048 bytes of headroom as xargs does; the
+ * size of the environment is cached until it changes. Under autobatch or
+ * the batch prefix an oversized command is run as several commands, each
+ * with as many operands as fit. Otherwise it fails with status 126 and a
+ * diagnosis, instead of a child that silently exits 1.
+ *
+ * Return: -1 if the command fits and is left to the caller, 0 otherwise.
+ */
+int run_batches(info_t *info_struct)
+{
+	long arg_max = sysconf(_SC_ARG_MAX);
+	size_t limit = (arg_max > 4096 ? arg_max : 131072) - 2048, fixed;
+	int nfixed;
+
+	if (!info_struct->env_bytes)
+		info_struct->env_bytes = argv_bytes(get_environ(info_struct), -1)
+			+ sizeof(char *);
+	if (argv_bytes(info_struct->argv, -1) + info_struct->env_bytes
+			+ sizeof(char *) <= limit)
+		return (-1);
+	nfixed = batch_fixed(info_struct->argv);
+	fixed = argv_bytes(info_struct->argv, nfixed) + info_struct->env_bytes
+		+ sizeof(char *);
+	if ((info_struct->autobatch || info_struct->batch_jobs) && fixed < limit)
+	{
+		info_struct->status = batch_run(info_struct, nfixed, limit - fixed);
+		return (0);
+	}
+	info_struct->status = 126;
+	print_error(info_struct, "Argument list too long\n");
+	return (0);
+}
+
+/**
+ * batch_run - Runs the batches of an oversized command.
+ * @info_struct: Pointer to the info structure.
+ * @nfixed: Number of leading arguments repeated in every batch.
+ * @room: Bytes left for operands in each batch.
+ *
+ * Description: Batches run one after another, or up to batch -j N at a
+ * time, as children of the shell watched by the child event loop.
+ *
+ * Return: 0 if every batch succeeded, else the status of the last batch
+ * to fail (128 plus the signal if it was killed).
+ */
+int batch_run(info_t *info_struct, int nfixed, size_t room)
+{
+	char **argv = info_struct->argv, **batch;
+	int jobs = info_struct->batch_jobs ? info_struct->batch_jobs : 1;
+	int start = nfixed, end, running = 0, status = 0;
+	child_t child;
+
+	for (end = 0; argv[end]; end++)
+		;
+	batch = malloc(sizeof(char *) * (end + 1));
+	if (!batch)
+		return (126);
+	for (end = 0; end < nfixed; end++)
+		batch[end] = argv[end];
+	while (argv[start] || running)
+	{
+		end = argv[start] && running < jobs
+			? batch_next(info_struct, start, room) : start;
+		if (end != start)
+		{
+			if (end == -1)
+				print_error(info_struct, "Argument list too long\n");
+			if (end != -1 && batch_spawn(info_struct, batch, nfixed,
+						start, end) == 0)
+				running++;
+			else /* give up on the operands left */
+				for (status = 126, end = start; argv[end]; end++)
+					;
+			start = end;
+			continue;
+		}
+		if (child_wait(info_struct, -1, 0, &child) != 0)
+			break;
+		running--;
+		end = WIFSIGNALED(child.status) ? 128 + WTERMSIG(child.status)
+			: WEXITSTATUS(child.status);
+		status = end ? end : status;
+	}
+	free(batch);
+	return (status);
+}
+
+/**
+ * batch_spawn - Starts one batch of an oversized command.
+ * @info_struct: Pointer to the info structure.
+ * @batch: Argument vector of the batch, holding the repeated arguments.
+ * @nfixed: Number of repeated arguments.
+ * @start: Index of the first operand of the batch in info_struct->argv.
+ * @end: Index one past its last operand.
+ *
+ * Description: @batch is reused for every batch; a child has its own copy
+ * of it from the moment it is forked.
+ *
+ * Return: 0 if the batch is running, -1 otherwise.
+ */
+int batch_spawn(info_t *info_struct, char **batch, int nfixed, int start,
+		int end)
+{
+	char **argv = info_struct->argv;
+	int count;
+	pid_t pid;
+
+	for (count = 0; start + count < end; count++)
+		batch[nfixed + count] = argv[start + count];
+	batch[nfixed + count] = NULL;
+	info_struct->argv = batch;
+	pid = fork_child(info_struct);
+	info_struct->argv = argv;
+	if (pid == -1)
+		return (-1);
+	if (child_watch(info_struct, pid) == -1)
+	{
+		COUNT_SYSCALL(SC_WAIT);
+		wait4(pid, NULL, 0, NULL);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * batch_next - Finds where the batch starting at an operand ends.
+ * @info_struct: Pointer to the info structure.
+ * @start: Index of the first operand of the batch.
+ * @room: Bytes left for operands in each batch.
+ *
+ * Description: Besides the total size, Linux caps every single string at
+ * 32 pages (MAX_ARG_STRLEN).
+ *
+ * Return: Index one past the last operand that fits, or -1 if not even
+ * the first one does.
+ */
+int batch_next(info_t *info_struct, int start, size_t room)
+{
+	char **argv = info_struct->argv;
+	size_t used = 0, size;
+	long max_str = sysconf(_SC_PAGESIZE) * 32;
+	int end;
+
+	for (end = start; argv[end]; end++)
+	{
+		size = _strlen(argv[end]) + 1 + sizeof(char *);
+		if ((long)size > max_str || used + size > room)
+			break;
+		used += size;
+	}
+	return (end > start ? end : -1);
+}
@@ -0,0 +1,44 @@
+#!/bin/sh
+# compare.sh - startup and per-command latency of two hsh builds
+#
+# Usage: bench/compare.sh BASE NEW [runs]
+#
+# Reports bench/startup.sh for each binary, then the mean time per command
+# of a 20k-line builtin script and of a 2k-line external command script,
+# best of RUNS (default 5).
+
+BASE=$1
+NEW=$2
+RUNS=${3:-5}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+awk 'BEGIN { for (i = 0; i < 20000; i++) print "alias a" i % 50 "=b" }' \
+	> "$DIR/builtins.sh"
+awk 'BEGIN { for (i = 0; i < 2000; i++) print "/bin/true" }' \
+	> "$DIR/external.sh"
+
+# per_cmd HSH SCRIPT LINES - best-of-RUNS nanoseconds per line
+per_cmd()
+{
+	best=0
+	i=0
+	while [ "$i" -lt "$RUNS" ]; do
+		start=$(date +%s%N)
+		"$1" "$2" > /dev/null 2>&1
+		end=$(date +%s%N)
+		took=$(((end - start) / $3))
+		if [ "$best" -eq 0 ] || [ "$took" -lt "$best" ]; then
+			best=$took
+		fi
+		i=$((i + 1))
+	done
+	echo "$best"
+}
+
+for hsh in "$BASE" "$NEW"; do
+	echo "== $hsh"
+	HSH=$hsh "$(dirname "$0")/startup.sh" 500 | sed -n 's/^hsh -c exit: */startup:  /p'
+	echo "builtin:  $(per_cmd "$hsh" "$DIR/builtins.sh" 20000) ns/cmd"
+	echo "external: $(per_cmd "$hsh" "$DIR/external.sh" 2000) ns/cmd"
+done
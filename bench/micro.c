@@ -0,0 +1,146 @@
+#include "micro.h"
+
+/**
+ * read_cycles - Reads the CPU timestamp counter.
+ *
+ * Return: The counter on x86-64, 0 elsewhere.
+ */
+unsigned long read_cycles(void)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+	unsigned int low, high;
+
+	__asm__ __volatile__("rdtsc" : "=a" (low), "=d" (high));
+	return (((unsigned long)high << 32) | low);
+#else
+	return (0);
+#endif
+}
+
+/**
+ * run_case - Times one function and prints its JSON object.
+ * @info_struct: Prepared state passed to the function.
+ * @mc: The case to run.
+ * @iters: Calls per repetition, before @mc's scale.
+ * @reps: Number of timed repetitions.
+ *
+ * Description: One untimed repetition warms caches and the allocator. The
+ * object holds the fastest and median ns per call and the median cycles per
+ * call over the repetitions.
+ */
+void run_case(info_t *info_struct, micro_case_t *mc, unsigned long iters,
+		int reps)
+{
+	double ns[MICRO_REPS_MAX], cycles[MICRO_REPS_MAX], swap;
+	unsigned long count, start, start_cycles;
+	int rep, index;
+
+	iters = iters / mc->scale ? iters / mc->scale : 1;
+	for (rep = -1; rep < reps; rep++)
+	{
+		start = now_ns();
+		start_cycles = read_cycles();
+		for (count = 0; count < iters; count++)
+			mc->func(info_struct);
+		if (rep < 0)
+			continue;
+		cycles[rep] = (double)(read_cycles() - start_cycles) / iters;
+		ns[rep] = (double)(now_ns() - start) / iters;
+		for (index = rep; index > 0 && ns[index] < ns[index - 1]; index--)
+			swap = ns[index], ns[index] = ns[index - 1], ns[index - 1] = swap;
+		for (index = rep; index > 0 && cycles[index] < cycles[index - 1];
+				index--)
+			swap = cycles[index], cycles[index] = cycles[index - 1],
+				cycles[index - 1] = swap;
+	}
+	printf("{\"name\":\"%s\",\"iterations\":%lu,\"reps\":%d,", mc->name,
+			iters, reps);
+	printf("\"ns_min\":%.2f,\"ns_median\":%.2f,\"cycles_median\":%.1f}",
+			ns[0], ns[reps / 2], cycles[reps / 2]);
+}
+
+/**
+ * micro_setup - Generates the inputs shared by the cases.
+ * @info_struct: State to fill.
+ *
+ * Description: arg gets a 20-word command line and env a list of 200
+ * variables ending with a six-directory PATH.
+ */
+void micro_setup(info_t *info_struct)
+{
+	static char line[256];
+	char name[32];
+	info_list *tail = NULL;
+	int count;
+
+	line[0] = '\0';
+	for (count = 0; count < 20; count++)
+		_strcat(line, count ? " word" : "/bin/echo");
+	info_struct->arg = line;
+	info_struct->fname = "micro";
+	for (count = 0; count < 199; count++)
+	{
+		sprintf(name, "VAR_%d=value_%d", count, count);
+		tail = add_node_end(tail ? &tail : &(info_struct->env), name, 0);
+	}
+	add_node_end(tail ? &tail : &(info_struct->env),
+			"PATH=/usr/local/sbin:/usr/local/bin:/usr/sbin:/usr/bin:/sbin:/bin",
+			0);
+	info_struct->env_ready = 1;
+}
+
+/**
+ * micro_num_str - Converts a 9-digit number to decimal.
+ * @info_struct: Prepared state; cmd_count is used as the number.
+ */
+void micro_num_str(info_t *info_struct)
+{
+	info_struct->status += *num_str_converter(
+			123456789 + info_struct->cmd_count++ % 16, 10, 0);
+}
+
+/**
+ * main - Runs the micro-benchmarks of libhsh's hot functions.
+ * @arg_c: The number of command-line arguments.
+ * @arg_v: [iterations per repetition [repetitions]].
+ *
+ * Description: The results are printed as one JSON object on stdout, so
+ * they can be stored per commit and compared.
+ *
+ * Return: 0 on success, 2 on a bad argument.
+ */
+int main(int arg_c, char **arg_v)
+{
+	micro_case_t cases[] = {
+		{"strtow", micro_strtow, 1},
+		{"get_env_var", micro_get_env_var, 1},
+		{"find_cmd_path", micro_find_cmd_path, 100},
+		{"linked_list_to_strings", micro_list_to_strings, 10},
+		{"_realloc", micro_realloc, 1},
+		{"num_str_converter", micro_num_str, 1},
+		{"complete_cmds", micro_complete_cmds, 100},
+		{NULL, NULL, 0}
+	};
+	info_t info_struct[] = { INFO_INIT };
+	unsigned long iters = arg_c > 1 ? (unsigned long)atol(arg_v[1]) : 100000;
+	int reps = arg_c > 2 ? atoi(arg_v[2]) : 11, count;
+
+	if (!iters || reps < 1 || reps > MICRO_REPS_MAX)
+	{
+		fprintf(stderr, "usage: %s [iterations [reps <= %d]]\n", arg_v[0],
+				MICRO_REPS_MAX);
+		return (2);
+	}
+	micro_setup(info_struct);
+	printf("{\"benchmarks\":[");
+	for (count = 0; cases[count].name; count++)
+	{
+		if (count)
+			putchar(',');
+		run_case(info_struct, &cases[count], iters, reps);
+	}
+	printf("]}\n");
+	free_list(&(info_struct->env));
+	comp_free(info_struct);
+	return (0);
+}
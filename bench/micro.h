@@ -0,0 +1,34 @@
+#ifndef _MICRO_H_
+#define _MICRO_H_
+
+#include <stdio.h>
+#include "../main.h"
+
+#define MICRO_REPS_MAX	101
+
+/**
+ * struct micro_case - One hot function timed by bench/micro
+ * @name: Name reported in the JSON output
+ * @func: Performs one call of the function on the prepared inputs
+ * @scale: Divisor of the iteration count, for calls that make syscalls
+ */
+typedef struct micro_case
+{
+	char *name;
+	void (*func)(info_t *);
+	int scale;
+} micro_case_t;
+
+unsigned long read_cycles(void);
+void run_case(info_t *, micro_case_t *, unsigned long, int);
+void micro_setup(info_t *);
+void micro_num_str(info_t *);
+
+void micro_strtow(info_t *);
+void micro_get_env_var(info_t *);
+void micro_find_cmd_path(info_t *);
+void micro_list_to_strings(info_t *);
+void micro_realloc(info_t *);
+void micro_complete_cmds(info_t *);
+
+#endif
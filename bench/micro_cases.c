@@ -0,0 +1,52 @@
+#include "micro.h"
+
+/**
+ * micro_strtow - Splits a 20-word command line.
+ * @info_struct: Prepared state; the line is in arg.
+ */
+void micro_strtow(info_t *info_struct)
+{
+	free_ptr_array(strtow(info_struct->arg, " \t"));
+}
+
+/**
+ * micro_get_env_var - Looks up PATH, the last of 200 environment entries.
+ * @info_struct: Prepared state; the list is in env.
+ */
+void micro_get_env_var(info_t *info_struct)
+{
+	info_struct->status += get_env_var(info_struct, "PATH=") != NULL;
+}
+
+/**
+ * micro_find_cmd_path - Resolves "sh" through a six-directory PATH.
+ * @info_struct: Prepared state.
+ */
+void micro_find_cmd_path(info_t *info_struct)
+{
+	info_struct->status += find_cmd_path(info_struct,
+			get_env_var(info_struct, "PATH="), "sh") != NULL;
+}
+
+/**
+ * micro_list_to_strings - Builds the envp array of 200 entries.
+ * @info_struct: Prepared state; the list is in env.
+ */
+void micro_list_to_strings(info_t *info_struct)
+{
+	free_ptr_array(linked_list_to_strings(info_struct->env));
+}
+
+/**
+ * micro_realloc - Grows a 64-byte block to 128 bytes.
+ * @info_struct: Unused.
+ */
+void micro_realloc(info_t *info_struct)
+{
+	char *block = malloc(64);
+
+	(void)info_struct;
+	if (block)
+		_memset(block, 'x', 64);
+	free(_realloc(block, 64, 128));
+}
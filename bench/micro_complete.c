@@ -0,0 +1,18 @@
+#include "micro.h"
+
+/**
+ * micro_complete_cmds - Completes "gr" as a command name.
+ * @info_struct: Prepared state; PATH is the last entry of env.
+ *
+ * Description: The PATH directories are only read by the first call;
+ * every call after it costs a stat() of each directory and a binary
+ * search.
+ */
+void micro_complete_cmds(info_t *info_struct)
+{
+	glob_res_t res = {NULL, 0, 0};
+
+	complete_cmds(info_struct, "gr", &res);
+	info_struct->status += res.count;
+	free_ptr_array(res.strs);
+}
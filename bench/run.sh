@@ -0,0 +1,132 @@
+#!/bin/sh
+# run.sh - end-to-end workloads for hsh, side by side with a reference shell
+#
+# Usage: bench/run.sh [runs]
+#	HSH       binary under test (default ./hsh)
+#	REF       reference shell (default /bin/dash, else /bin/sh)
+#	SAVE      file to write the hsh results to, for a later BASELINE
+#	BASELINE  file from an earlier SAVE; exits 1 if a workload got more
+#	          than 10% slower (ops/sec) than in it
+#
+# Every workload is generated under a temporary directory and run RUNS
+# times by each shell. For each shell the report gives ops/sec from the mean
+# wall time, the p99 wall time of a single run in ms, and the max RSS in kB
+# of the shell (read from $HSH_MAXRSS of an extra run under hsh; for the
+# history workload, from what the "times" builtin reports inside hsh).
+# Workloads:
+#	startup    sh -c exit
+#	builtins   100k "alias" lines
+#	external   10k /bin/true lines
+#	longline   one 1 MB input line
+#	env        200 /bin/true $V9999 lines with 10k exported variables
+#	history    interactive start, times and exit with a 1M-entry history file
+#	           (hsh only, needs script(1))
+#	aliases    10k lines through a 9-deep alias chain
+
+HSH=${HSH:-./hsh}
+REF=${REF:-/bin/dash}
+RUNS=${1:-5}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+[ -x "$REF" ] || REF=/bin/sh
+case $HSH in
+	/*) ;;
+	*) HSH=$(pwd)/$HSH ;;
+esac
+
+awk 'BEGIN { for (i = 0; i < 100000; i++) print "alias a" i % 100 "=b" }' \
+	> "$DIR/builtins.sh"
+awk 'BEGIN { for (i = 0; i < 10000; i++) print "/bin/true" }' \
+	> "$DIR/external.sh"
+awk 'BEGIN { printf "alias"; for (i = 0; i < 262144; i++) printf " a=b";
+	print "" }' > "$DIR/longline.sh"
+awk 'BEGIN { for (i = 0; i < 200; i++) print "/bin/true $V9999" }' \
+	> "$DIR/env.sh"
+awk 'BEGIN { for (i = 0; i < 8; i++) print "alias c" i "=c" i + 1;
+	print "alias c8=alias";
+	for (i = 0; i < 10000; i++) print "c0 x=y" }' > "$DIR/aliases.sh"
+mkdir "$DIR/home"
+awk 'BEGIN { for (i = 0; i < 1000000; i++) print "echo " i }' \
+	> "$DIR/home/.hsh_shell_history"
+cat > "$DIR/history.sh" <<EOF
+#!/bin/sh
+printf 'times\nexit\n' | HOME=$DIR/home script -qc "\$1" "$DIR/typescript" \
+	> /dev/null
+sed -n 's/^shell: .* maxrss \([0-9]*\)k.*/\1/p' "$DIR/typescript" \
+	> "$DIR/history_rss"
+cp "$DIR/home/.hsh_shell_history.1m" "$DIR/home/.hsh_shell_history"
+EOF
+chmod +x "$DIR/history.sh"
+cp "$DIR/home/.hsh_shell_history" "$DIR/home/.hsh_shell_history.1m"
+awk 'BEGIN { for (i = 0; i < 10000; i++) print "export V" i "=value" i }' \
+	> "$DIR/env_vars"
+
+# run_workload SHELL OPS ARGS... - prints "ops/sec p99_ms rss_kb"
+run_workload()
+{
+	sh=$1
+	ops=$2
+	shift 2
+	: > "$DIR/times"
+	i=0
+	while [ "$i" -lt "$RUNS" ]; do
+		start=$(date +%s%N)
+		"$sh" "$@" > /dev/null 2>&1 < /dev/null
+		end=$(date +%s%N)
+		echo $((end - start)) >> "$DIR/times"
+		i=$((i + 1))
+	done
+	rss=$("$HSH" -c "$sh $*; /bin/echo \$HSH_MAXRSS" 2> /dev/null < /dev/null)
+	sort -n "$DIR/times" | awk -v ops="$ops" -v rss="$rss" '
+		{ t[NR] = $1; sum += $1 }
+		END {
+			idx = int(NR * 0.99 + 0.99)
+			printf "%.0f %.2f %s\n", ops * NR * 1e9 / sum, t[idx] / 1e6, rss
+		}'
+}
+
+# report NAME HSH_RESULT REF_RESULT - prints a table row, saves hsh's
+report()
+{
+	echo "$1 $2 $3" | awk '{
+		printf "%-10s %12s %9s %8s   %12s %9s %8s\n",
+			$1, $2, $3, $4, $5, $6, $7 }'
+	echo "$1 $2" >> "$DIR/results"
+}
+
+# bench NAME OPS ARGS... - runs one workload under both shells
+bench()
+{
+	name=$1
+	ops=$2
+	shift 2
+	report "$name" "$(run_workload "$HSH" "$ops" "$@")" \
+		"$(run_workload "$REF" "$ops" "$@")"
+}
+
+printf "%-10s %12s %9s %8s   %12s %9s %8s\n" workload "hsh ops/s" \
+	"p99 ms" "rss kB" "$(basename "$REF") ops/s" "p99 ms" "rss kB"
+bench startup 1 -c exit
+bench builtins 100000 "$DIR/builtins.sh"
+bench external 10000 "$DIR/external.sh"
+bench longline 1 "$DIR/longline.sh"
+(
+	. "$DIR/env_vars"
+	bench env 200 "$DIR/env.sh"
+)
+if command -v script > /dev/null; then
+	# the rss of the wrapper is not hsh's: take what "times" printed
+	set -- $(run_workload "$DIR/history.sh" 1 "$HSH")
+	report history "$1 $2 $(cat "$DIR/history_rss")" "- - -"
+fi
+bench aliases 10000 "$DIR/aliases.sh"
+
+[ -n "$SAVE" ] && cp "$DIR/results" "$SAVE"
+[ -z "$BASELINE" ] && exit 0
+awk 'NR == FNR { base[$1] = $2; next }
+	($1 in base) && $2 < base[$1] * 0.9 {
+		printf "REGRESSION: %s %s ops/s, baseline %s\n", $1, $2, base[$1]
+		bad = 1
+	}
+	END { exit bad }' "$BASELINE" "$DIR/results"
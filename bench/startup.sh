@@ -0,0 +1,29 @@
+#!/bin/sh
+# startup.sh - time from exec to the first command for hsh
+#
+# Usage: bench/startup.sh [runs]	(HSH overrides the binary, default ./hsh)
+#
+# Runs "hsh -c exit" repeatedly and reports the mean wall time per run,
+# next to /bin/true as the floor set by fork+exec alone.
+
+HSH=${HSH:-./hsh}
+RUNS=${1:-2000}
+
+run_loop()
+{
+	start=$(date +%s%N)
+	i=0
+	while [ "$i" -lt "$RUNS" ]; do
+		"$@"
+		i=$((i + 1))
+	done
+	end=$(date +%s%N)
+	echo $(((end - start) / RUNS / 1000))
+}
+
+floor=$(run_loop /bin/true)
+total=$(run_loop "$HSH" -c exit)
+echo "runs:              $RUNS"
+echo "/bin/true:         ${floor} us/run"
+echo "hsh -c exit:       ${total} us/run"
+echo "time to first cmd: $((total - floor)) us over exec floor"
@@ -0,0 +1,31 @@
+#!/bin/sh
+# syscall_budget.sh - fail if the main loop makes too many syscalls
+#
+# Usage: bench/syscall_budget.sh [lines] [budget]  (HSH overrides ./hsh)
+#
+# Runs a script of builtin-only lines under --syscall-stats and exits 1
+# when the syscalls per executed command exceed the budget. The default,
+# 0.05, allows one read per input buffer plus the fixed startup cost; any
+# per-line syscall in the loop pushes the ratio above 1.
+
+HSH=${HSH:-./hsh}
+LINES=${1:-1000}
+BUDGET=${2:-0.05}
+SCRIPT=$(mktemp)
+trap 'rm -f "$SCRIPT"' EXIT
+
+i=0
+while [ "$i" -lt "$LINES" ]; do
+	echo "alias a$i=b"
+	i=$((i + 1))
+done > "$SCRIPT"
+
+report=$("$HSH" --syscall-stats "$SCRIPT" 2>&1 >/dev/null)
+echo "$report"
+per_cmd=$(echo "$report" | sed -n 's/.* \([0-9.]*\) per command/\1/p')
+if awk -v got="$per_cmd" -v max="$BUDGET" 'BEGIN { exit !(got > max) }'
+then
+	echo "FAIL: $per_cmd syscalls per command, budget $BUDGET"
+	exit 1
+fi
+echo "OK: $per_cmd syscalls per command, budget $BUDGET"
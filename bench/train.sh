@@ -0,0 +1,39 @@
+#!/bin/sh
+# train.sh - profile training run for the PGO release build
+#
+# Usage: bench/train.sh		(HSH is the instrumented binary, default ./hsh)
+#
+# Exercises the paths that dominate real use, in rough proportion: startup
+# with -c, builtin and alias lines, PATH lookups and external commands,
+# variable expansion and shell functions. "make release" runs it between
+# the -fprofile-generate and -fprofile-use builds. Output is discarded.
+
+HSH=${HSH:-./hsh}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+awk 'BEGIN {
+	print "alias l=ls"
+	print "greet() {"
+	print "	alias g$1=$2"
+	print "	/bin/true $1 && alias last=$1"
+	print "}"
+	for (i = 0; i < 20000; i++) {
+		print "alias a" i % 50 "=b" i
+		if (i % 10 == 0) print "true $HOME $PATH $? $$"
+		if (i % 10 == 5) print "greet x" i % 7 " y"
+		if (i % 100 == 0) print "setenv T" i % 20 " v" i
+		if (i % 1000 == 0) print "env"
+	}
+	print "stats"
+	print "times"
+}' > "$DIR/mixed.sh"
+
+i=0
+while [ "$i" -lt 200 ]; do
+	"$HSH" -c exit
+	"$HSH" -c "alias x=y; cd /; /bin/true"
+	i=$((i + 1))
+done
+"$HSH" "$DIR/mixed.sh" > /dev/null 2>&1
+"$HSH" < "$DIR/mixed.sh" > /dev/null 2>&1
@@ -0,0 +1,84 @@
+#include "main.h"
+
+/**
+ * batch_fixed - Counts the arguments repeated in every batch.
+ * @argv: The command.
+ *
+ * Description: The command name and the options that follow it, up to
+ * and including a "--", are kept in every batch; the operands after them
+ * are split up.
+ *
+ * Return: The number of leading arguments to repeat.
+ */
+int batch_fixed(char **argv)
+{
+	int count = 1;
+
+	while (argv[count] && argv[count][0] == '-' && argv[count + 1])
+		if (_strcmp(argv[count++], "--") == 0)
+			break;
+	return (count);
+}
+
+/**
+ * hsh_batch - Handles the batch prefix.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: -2 if the command asked the shell to exit, 0 otherwise.
+ *
+ * Description: "batch [-j N] cmd args..." runs cmd like any command, but
+ * should its arguments not fit one execve() they are split into batches
+ * as with "set -o autobatch", up to N of them running at once.
+ */
+int hsh_batch(info_t *info_struct)
+{
+	int shift = 1, jobs = 1, result;
+
+	if (info_struct->argv[1] && _strcmp(info_struct->argv[1], "-j") == 0)
+	{
+		jobs = info_struct->argv[2] ? parse_unsigned_Int(info_struct->argv[2])
+			: -1;
+		shift = 3;
+	}
+	if (jobs < 1 || !info_struct->argv[shift])
+	{
+		print_error(info_struct, "usage: batch [-j N] cmd args...\n");
+		info_struct->status = 2;
+		return (0);
+	}
+	info_struct->batch_jobs = jobs;
+	result = dispatch_rest(info_struct, shift);
+	info_struct->batch_jobs = 0;
+	return (result == -2 ? -2 : 0);
+}
+
+/**
+ * hsh_set - Handles the set builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: Always 0.
+ *
+ * Description: "set -o autobatch" and "set +o autobatch" turn automatic
+ * batching of oversized argument lists on and off; "set -o" or "set"
+ * alone lists the option. Anything else sets status 2.
+ */
+int hsh_set(info_t *info_struct)
+{
+	char **argv = info_struct->argv;
+
+	if (!argv[1] || (_strcmp(argv[1], "-o") == 0 && !argv[2]))
+	{
+		_puts("autobatch\t");
+		_puts(info_struct->autobatch ? "on\n" : "off\n");
+		return (0);
+	}
+	if ((_strcmp(argv[1], "-o") == 0 || _strcmp(argv[1], "+o") == 0)
+			&& _strcmp(argv[2], "autobatch") == 0 && !argv[3])
+	{
+		info_struct->autobatch = argv[1][0] == '-';
+		return (0);
+	}
+	print_error(info_struct, "usage: set -o|+o autobatch\n");
+	info_struct->status = 2;
+	return (0);
+}
@@ -74,6 +74,7 @@ int hsh_cd(info_t *info_struct)
 	char *current_dir, *dir, buffer[1024];
 	int ch_d;
 
+	COUNT_SYSCALL(SC_GETCWD);
 	current_dir = getcwd(buffer, 1024);
 	if (!current_dir)
 		_puts("TODO: >>getcwd failure emsg here<<\n");
@@ -98,6 +99,7 @@ int hsh_cd(info_t *info_struct)
 	}
 	else /* Change to specified directory */
 		ch_d = chdir(info_struct->argv[1]);
+	COUNT_SYSCALL(SC_CHDIR);
 	if (ch_d == -1) /* Handle chdir error */
 	{
 		print_error(info_struct, "can't cd to ");
@@ -106,6 +108,7 @@ int hsh_cd(info_t *info_struct)
 	else
 	{
 		_setenv(info_struct, "OLDPWD", get_env_var(info_struct, "PWD="));
+		COUNT_SYSCALL(SC_GETCWD);
 		_setenv(info_struct, "PWD", getcwd(buffer, 1024));
 	}
 	return (0); /* Return 0 on success */
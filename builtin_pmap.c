@@ -0,0 +1,174 @@
+#include "main.h"
+
+/**
+ * hsh_pmap - Handles the pmap builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: Always 0; the status is 0 if every job succeeded, 1 if any
+ * failed and 2 on bad arguments.
+ *
+ * Description: "pmap [-j N] [-f FILE] [-k|--keep-order] [--pin] cmd args"
+ * runs cmd once per non-empty line of FILE or standard input, with {} in
+ * its arguments replaced by the line, or the line appended if there is no
+ * {}. Up to N commands (by default one per CPU) run at once, as children
+ * of the shell. Lines are read with the shell's own line reader, only as
+ * fast as jobs are started; see pmap_reader(). Failures are reported as
+ * they happen and summed up at the end.
+ */
+int hsh_pmap(info_t *info_struct)
+{
+	pmap_t pm;
+	info_t *reader;
+
+	info_struct->status = 2;
+	if (pmap_parse(info_struct, &pm) == -1)
+		return (0);
+	reader = pmap_reader(info_struct, &pm);
+	pm.ring = malloc(sizeof(pmap_job_t) * pm.slots);
+	if (!reader || !pm.ring)
+	{
+		print_error(info_struct, "can't read items\n");
+		if (reader != info_struct)
+			hsh_free(reader);
+		return (free(pm.ring), 0);
+	}
+	_memset((char *)pm.ring, 0, sizeof(pmap_job_t) * pm.slots);
+	_putchar(BUF_FLUSH);
+	pmap_run(info_struct, &pm, reader);
+	if (pm.file)
+		close(reader->readfd);
+	if (reader != info_struct)
+		hsh_free(reader);
+	free(pm.ring);
+	if (pm.saved_out != -1)
+		close(pm.saved_out);
+	if (pm.failed)
+	{
+		print_string(info_struct->fname);
+		print_string(": pmap: ");
+		print_string(num_str_converter(pm.failed, 10, 0));
+		print_string(" of ");
+		print_string(num_str_converter(pm.started, 10, 0));
+		print_string(" jobs failed\n");
+		print_char(BUF_FLUSH);
+	}
+	info_struct->status = pm.failed ? 1 : 0;
+	return (0);
+}
+
+/**
+ * pmap_parse - Parses the options of the pmap builtin.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The state to initialise.
+ *
+ * Return: 0 on success, -1 after printing a usage message.
+ */
+int pmap_parse(info_t *info_struct, pmap_t *pm)
+{
+	char **argv = info_struct->argv + 1;
+	int bad = 0;
+
+	_memset((char *)pm, 0, sizeof(*pm));
+	pm->saved_out = -1;
+	pm->jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	for (; *argv && **argv == '-' && !bad; argv++)
+	{
+		if (_strcmp(*argv, "--") == 0 && argv++)
+			break;
+		if (_strcmp(*argv, "-j") == 0 && argv[1])
+			pm->jobs = parse_unsigned_Int(*++argv);
+		else if (_strcmp(*argv, "-f") == 0 && argv[1])
+			pm->file = *++argv;
+		else if (!_strcmp(*argv, "-k") || !_strcmp(*argv, "--keep-order"))
+			pm->keep_order = 1;
+		else if (_strcmp(*argv, "--pin") == 0)
+			pm->pin = 1;
+		else
+			bad = 1;
+	}
+	if (bad || !*argv || pm->jobs < 1)
+	{
+		print_error(info_struct, "usage: pmap [-j N] [-f FILE] "
+				"[-k|--keep-order] [--pin] cmd [args with {}]\n");
+		return (-1);
+	}
+	pm->tmpl = argv;
+	pm->slots = pm->keep_order ? pm->jobs * 4 : pm->jobs;
+	COUNT_SYSCALL(SC_EVENT);
+	if (pm->pin && syscall(SYS_sched_getaffinity, 0, sizeof(pm->cpus),
+				pm->cpus) > 0)
+		for (bad = 0; bad < PMAP_CPU_WORDS * 8 * (int)sizeof(long); bad++)
+			pm->cpu_count += (pm->cpus[bad / (8 * sizeof(long))]
+					>> (bad % (8 * sizeof(long)))) & 1;
+	return (0);
+}
+
+
+/**
+ * pmap_run - Runs the jobs of the pmap builtin.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The pmap state.
+ * @reader: Interpreter whose line reader reads the items.
+ *
+ * Description: A line is only read when a job can be started for it:
+ * fewer than pm->jobs are running and, with --keep-order, the jobs not
+ * yet written out fit in pm->ring. Otherwise the next job to finish is
+ * waited for.
+ */
+void pmap_run(info_t *info_struct, pmap_t *pm, info_t *reader)
+{
+	char *line;
+	int len = 0;
+
+	while (len != -1 || pm->running)
+	{
+		if (len != -1 && pm->running < pm->jobs
+				&& (unsigned long)pm->slots > pm->started - pm->next_out)
+		{
+			line = NULL;
+			len = get_stdin_line(reader, &line, NULL);
+			if (len > 0 && line[len - 1] == '\n')
+				line[--len] = '\0';
+			if (len <= 0 || pmap_start(info_struct, pm, line) == -1)
+				free(line);
+			continue;
+		}
+		pmap_reap(info_struct, pm);
+	}
+}
+
+/**
+ * pmap_reader - Picks the interpreter whose line reader reads the items.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The pmap state.
+ *
+ * Description: When the shell reads its own commands from standard input,
+ * it has likely buffered the item lines already, so the items are read
+ * through the shell's reader itself. pmap reads up to end of file, so
+ * every remaining input line becomes an item and the shell exits after
+ * pmap. Items from FILE, or from standard input while the commands come
+ * from elsewhere, get a reader of their own, from hsh_new().
+ *
+ * Return: The reader, or NULL on failure.
+ */
+info_t *pmap_reader(info_t *info_struct, pmap_t *pm)
+{
+	info_t *reader;
+
+	if (!pm->file && info_struct->readfd == 0 && !info_struct->cmd_str)
+		return (info_struct);
+	reader = hsh_new(info_struct->fname);
+	if (!reader)
+		return (NULL);
+	reader->cmd_str = NULL;
+	if (!pm->file)
+		return (reader);
+	COUNT_SYSCALL(SC_OPEN);
+	reader->readfd = open(pm->file, O_RDONLY | O_CLOEXEC);
+	if (reader->readfd == -1)
+	{
+		hsh_free(reader);
+		return (NULL);
+	}
+	return (reader);
+}
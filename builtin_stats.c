@@ -0,0 +1,64 @@
+#include "main.h"
+
+/**
+ * print_latency - Prints the summary line of one latency histogram.
+ * @name: Label of the histogram.
+ * @hist: The histogram.
+ *
+ * Description: The line holds the count, p50, p90, p99 and max, all in
+ * nanoseconds, e.g. "builtin count=12 p50=959 p90=1919 p99=2431 max=2410".
+ */
+void print_latency(char *name, latency_hist_t *hist)
+{
+	_puts(name);
+	_puts(" count=");
+	_puts(num_str_converter(hist->count, 10, 0));
+	_puts(" p50=");
+	_puts(num_str_converter(hist_percentile(hist, 50), 10, 0));
+	_puts(" p90=");
+	_puts(num_str_converter(hist_percentile(hist, 90), 10, 0));
+	_puts(" p99=");
+	_puts(num_str_converter(hist_percentile(hist, 99), 10, 0));
+	_puts(" max=");
+	_puts(num_str_converter(hist->max_ns, 10, 0));
+	_putchar('\n');
+}
+
+/**
+ * hsh_stats - Handles the stats builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: 0 on success, 1 on an unknown option.
+ *
+ * Description: This function prints the latency distribution of builtins,
+ * external commands and PATH lookups recorded so far. "stats -r" clears
+ * the histograms instead.
+ */
+int hsh_stats(info_t *info_struct)
+{
+	latency_hist_t empty;
+
+	if (info_struct->argv[1] && _strcmp(info_struct->argv[1], "-r") == 0)
+	{
+		if (info_struct->latency)
+			_memset((void *)info_struct->latency, 0,
+					sizeof(latency_hist_t) * LAT_MAX);
+		return (0);
+	}
+	if (info_struct->argv[1])
+	{
+		print_error(info_struct, "Illegal option ");
+		print_string(info_struct->argv[1]);
+		print_char('\n');
+		return (1);
+	}
+
+	_memset((void *)&empty, 0, sizeof(empty));
+	print_latency("builtin", info_struct->latency
+			? &info_struct->latency[LAT_BUILTIN] : &empty);
+	print_latency("external", info_struct->latency
+			? &info_struct->latency[LAT_EXTERNAL] : &empty);
+	print_latency("path", info_struct->latency
+			? &info_struct->latency[LAT_PATH] : &empty);
+	return (0);
+}
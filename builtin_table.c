@@ -0,0 +1,34 @@
+#include "main.h"
+
+/**
+ * builtin_list - Returns the table of built-in commands.
+ *
+ * Description: search_builtin() runs the commands of this table and tab
+ * completion offers their names. The table ends with a NULL entry.
+ *
+ * Return: The table.
+ */
+builtin_table *builtin_list(void)
+{
+	static builtin_table builtintbl[] = {
+		{"exit", hsh_exit},
+		{"env", display_env_var},
+		{"help", hsh_help},
+		{"history", hsh_history},
+		{"setenv", update_env_var},
+		{"unsetenv", clear_all_env_var},
+		{"cd", hsh_cd},
+		{"alias", hsh_alias},
+		{"exec", hsh_exec},
+		{"time", hsh_time},
+		{"times", hsh_times},
+		{"stats", hsh_stats},
+		{"timeout", hsh_timeout},
+		{"pmap", hsh_pmap},
+		{"batch", hsh_batch},
+		{"set", hsh_set},
+		{NULL, NULL}
+	};
+
+	return (builtintbl);
+}
@@ -0,0 +1,193 @@
+#include "main.h"
+
+/**
+ * hsh_timeout - Handles the timeout builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: Always 0; the status is set as by coreutils timeout(1).
+ *
+ * Description: "timeout [-s SIG] [-k KILLAFTER] DURATION cmd..." runs an
+ * external command as a child of the shell, without a helper process.
+ * Once DURATION has passed the command is sent SIG (TERM by default),
+ * then KILL once KILLAFTER has passed as well. A DURATION or KILLAFTER
+ * of 0 disables that step. Bad arguments set status 125.
+ */
+int hsh_timeout(info_t *info_struct)
+{
+	unsigned long limits[2] = {0, 0};
+	int sig = SIGTERM, index = 1;
+	char **argv = info_struct->argv;
+
+	while (argv[index] && argv[index][0] == '-')
+	{
+		if (_strcmp(argv[index], "--") == 0 && ++index)
+			break;
+		if (_strcmp(argv[index], "-s") == 0 && argv[index + 1])
+			sig = parse_signal(argv[index + 1]);
+		else if (_strcmp(argv[index], "-k") || !argv[index + 1]
+				|| parse_duration(argv[index + 1], &limits[1]) == -1)
+			sig = -1;
+		if (sig == -1)
+			break;
+		index += 2;
+	}
+	if (sig == -1 || !argv[index] || !argv[index + 1]
+			|| parse_duration(argv[index], &limits[0]) == -1)
+	{
+		print_error(info_struct,
+				"usage: timeout [-s SIG] [-k KILLAFTER] DURATION cmd...\n");
+		info_struct->status = 125;
+		return (0);
+	}
+	info_struct->status = timeout_run(info_struct, index + 1, limits, sig);
+	return (0);
+}
+
+/**
+ * parse_duration - Parses a timeout(1) duration.
+ * @str: A decimal number of seconds, optionally with a fraction and an
+ * s, m, h or d suffix.
+ * @ns: Where to store the duration in nanoseconds; durations beyond a
+ * few centuries are clamped.
+ *
+ * Return: 0 on success, -1 on a malformed duration.
+ */
+int parse_duration(char *str, unsigned long *ns)
+{
+	unsigned long whole = 0, frac = 0, scale = 1000000000UL, unit = 1;
+	char *pos = str;
+
+	for (; *pos >= '0' && *pos <= '9'; pos++)
+		if (whole < 10000000000UL)
+			whole = whole * 10 + (*pos - '0');
+	if (*pos == '.')
+		for (pos++; *pos >= '0' && *pos <= '9'; pos++)
+			frac += (scale /= 10) * (*pos - '0');
+	if (pos == str || (pos == str + 1 && *str == '.'))
+		return (-1);
+	if (*pos == 'm')
+		unit = 60;
+	else if (*pos == 'h')
+		unit = 3600;
+	else if (*pos == 'd')
+		unit = 86400;
+	else if (*pos && *pos != 's')
+		return (-1);
+	if (*pos && pos[1])
+		return (-1);
+	if (whole > 10000000000UL / unit)
+		whole = 10000000000UL / unit;
+	*ns = (whole * 1000000000UL + frac) * unit;
+	return (0);
+}
+
+/**
+ * parse_signal - Parses a signal name or number.
+ * @name: A number, or a name such as TERM or SIGTERM.
+ *
+ * Return: The signal number, or -1 if it is unknown.
+ */
+int parse_signal(char *name)
+{
+	char *names[] = {"HUP", "INT", "QUIT", "KILL", "USR1", "USR2", "ALRM",
+		"TERM", "CONT", "STOP", NULL};
+	int numbers[] = {SIGHUP, SIGINT, SIGQUIT, SIGKILL, SIGUSR1, SIGUSR2,
+		SIGALRM, SIGTERM, SIGCONT, SIGSTOP};
+	int index;
+
+	if (*name >= '0' && *name <= '9')
+	{
+		index = parse_unsigned_Int(name);
+		return (index > 0 && index < NSIG ? index : -1);
+	}
+	if (starts_with(name, "SIG"))
+		name += 3;
+	for (index = 0; names[index]; index++)
+		if (_strcmp(name, names[index]) == 0)
+			return (numbers[index]);
+	return (-1);
+}
+
+/**
+ * timeout_run - Runs the command of a timeout builtin.
+ * @info_struct: Pointer to the info structure.
+ * @first: Index of the command in info_struct->argv.
+ * @limits: The duration and the kill-after delay, in nanoseconds.
+ * @sig: The signal sent once the duration has passed.
+ *
+ * Return: 124 if the command timed out, 128+9 if it had to be killed,
+ * 127 if it was not found, 126 if it could not be run, 125 if the shell
+ * could not start it, its exit status (or 128 plus the signal that
+ * killed it) otherwise.
+ */
+int timeout_run(info_t *info_struct, int first, unsigned long *limits,
+		int sig)
+{
+	char **argv = info_struct->argv;
+	unsigned long start = now_ns();
+	child_t child;
+	pid_t pid;
+	int timed_out, status;
+
+	info_struct->argv += first;
+	info_struct->path = find_cmd_path(info_struct,
+			get_env_var(info_struct, "PATH="), info_struct->argv[0]);
+	if (!info_struct->path && _strchr(info_struct->argv[0], '/')
+			&& is_exe_cmd(info_struct, info_struct->argv[0]))
+		info_struct->path = info_struct->argv[0];
+	pid = info_struct->path ? fork_child(info_struct) : -1;
+	if (!info_struct->path)
+		print_error(info_struct, "not found\n");
+	info_struct->argv = argv;
+	if (pid == -1)
+		return (info_struct->path ? 125 : 127);
+	timed_out = timeout_wait(info_struct, pid, limits, sig, &child);
+	record_usage(info_struct, &child.usage, now_ns() - start);
+	info_struct->child_pid = pid;
+	status = WIFSIGNALED(child.status) ? 128 + WTERMSIG(child.status)
+		: WEXITSTATUS(child.status);
+	if (timed_out && status != 128 + SIGKILL)
+		status = 124;
+	return (status);
+}
+
+/**
+ * timeout_wait - Waits for a timed command, signalling it when it is due.
+ * @info_struct: Pointer to the info structure.
+ * @pid: The command.
+ * @limits: The duration and the kill-after delay, in nanoseconds.
+ * @sig: The signal sent once the duration has passed.
+ * @child: Where to store the command once it has exited.
+ *
+ * Description: Both deadlines are timerfd expiries in the child event
+ * loop, so nothing polls or sleeps. As in timeout(1), a stopped command
+ * is also sent SIGCONT so it can act on @sig.
+ *
+ * Return: 1 if the duration passed before the command exited, else 0.
+ */
+int timeout_wait(info_t *info_struct, pid_t pid, unsigned long *limits,
+		int sig, child_t *child)
+{
+	unsigned long deadline = limits[0] ? now_ns() + limits[0] : 0;
+
+	if (child_watch(info_struct, pid) == -1)
+	{
+		COUNT_SYSCALL(SC_WAIT);
+		wait4(pid, &child->status, 0, &child->usage);
+		return (0);
+	}
+	if (child_wait(info_struct, pid, deadline, child) == 0)
+		return (0);
+	COUNT_SYSCALL(SC_KILL);
+	kill(pid, sig);
+	if (sig != SIGKILL && sig != SIGCONT)
+		kill(pid, SIGCONT);
+	deadline = limits[1] ? now_ns() + limits[1] : 0;
+	if (child_wait(info_struct, pid, deadline, child) == 1)
+	{
+		COUNT_SYSCALL(SC_KILL);
+		kill(pid, SIGKILL);
+		child_wait(info_struct, pid, 0, child);
+	}
+	return (1);
+}
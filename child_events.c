@@ -0,0 +1,183 @@
+#include "main.h"
+
+/**
+ * child_loop_init - Sets up the child event loop on first use.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The loop is an epoll instance watching one pidfd per child
+ * and a timerfd for deadlines. Events carry the pid of the child, or
+ * CHILD_TIMER or CHILD_SIGCHLD.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int child_loop_init(info_t *info_struct)
+{
+	struct epoll_event event;
+
+	if (info_struct->epoll_fd != -1)
+		return (0);
+	COUNT_SYSCALL(SC_EVENT);
+	info_struct->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	COUNT_SYSCALL(SC_EVENT);
+	info_struct->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	_memset((char *)&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u64 = CHILD_TIMER;
+	COUNT_SYSCALL(SC_EVENT);
+	if (info_struct->timer_fd == -1 || info_struct->epoll_fd == -1
+			|| epoll_ctl(info_struct->epoll_fd, EPOLL_CTL_ADD,
+				info_struct->timer_fd, &event) == -1)
+	{
+		child_loop_free(info_struct);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * child_watch - Hands a child process over to the child event loop.
+ * @info_struct: Pointer to the info_t structure.
+ * @pid: The child, as returned by fork().
+ *
+ * Description: The child gets a pidfd, which becomes readable once it
+ * exits. Without pidfd_open() (before Linux 5.3) the loop falls back to a
+ * SIGCHLD self-pipe. Either way only watched children are ever reaped, so
+ * a wait for one child never collects another.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int child_watch(info_t *info_struct, pid_t pid)
+{
+	struct epoll_event event;
+	child_t *child;
+
+	if (child_loop_init(info_struct) == -1)
+		return (-1);
+	if (info_struct->child_count == info_struct->child_max)
+	{
+		child = _realloc(info_struct->children,
+				sizeof(child_t) * info_struct->child_max,
+				sizeof(child_t) * (info_struct->child_max * 2 + 4));
+		if (!child)
+			return (-1);
+		info_struct->children = child;
+		info_struct->child_max = info_struct->child_max * 2 + 4;
+	}
+	child = &info_struct->children[info_struct->child_count];
+	_memset((char *)child, 0, sizeof(*child));
+	child->pid = pid;
+	child->pidfd = -1;
+#ifdef SYS_pidfd_open
+	COUNT_SYSCALL(SC_EVENT);
+	child->pidfd = syscall(SYS_pidfd_open, pid, 0);
+#endif
+	event.events = EPOLLIN;
+	event.data.u64 = pid;
+	info_struct->child_count++;
+	COUNT_SYSCALL(SC_EVENT);
+	if (child->pidfd == -1 || epoll_ctl(info_struct->epoll_fd,
+				EPOLL_CTL_ADD, child->pidfd, &event) == -1)
+		return (sigchld_fallback(info_struct));
+	return (0);
+}
+
+/**
+ * child_wait - Waits for a watched child to exit.
+ * @info_struct: Pointer to the info_t structure.
+ * @pid: The child to wait for, or -1 for any watched child.
+ * @deadline: now_ns() time to give up at, 0 to wait as long as it takes.
+ * @child: Where to store the child once it has exited; it is then no
+ * longer watched.
+ *
+ * Description: The deadline is an absolute timerfd expiry, so it is met
+ * to the clock's precision however often the wait is interrupted.
+ *
+ * Return: 0 once the child exited, 1 if the deadline passed first, -1 if
+ * no such child is watched.
+ */
+int child_wait(info_t *info_struct, pid_t pid, unsigned long deadline,
+		child_t *child)
+{
+	struct epoll_event events[8];
+	struct itimerspec timer;
+	int index, count;
+
+	_memset((char *)&timer, 0, sizeof(timer));
+	timer.it_value.tv_sec = deadline / 1000000000UL;
+	timer.it_value.tv_nsec = deadline % 1000000000UL;
+	COUNT_SYSCALL(SC_EVENT);
+	if (deadline && timerfd_settime(info_struct->timer_fd, TFD_TIMER_ABSTIME,
+				&timer, NULL) == -1)
+		return (-1);
+	while ((index = child_find(info_struct, pid)) >= 0
+			&& !info_struct->children[index].done)
+	{
+		if (deadline && now_ns() >= deadline)
+			return (1);
+		COUNT_SYSCALL(SC_EVENT);
+		count = epoll_wait(info_struct->epoll_fd, events, 8, -1);
+		while (count-- > 0)
+			child_event(info_struct, &events[count]);
+	}
+	if (index < 0)
+		return (-1);
+	*child = info_struct->children[index];
+	info_struct->children[index] =
+		info_struct->children[--info_struct->child_count];
+	return (0);
+}
+
+/**
+ * child_find - Looks up a watched child.
+ * @info_struct: Pointer to the info_t structure.
+ * @pid: The child, or -1 for any watched child, preferring one that has
+ * exited.
+ *
+ * Return: Its index in info_struct->children, or -1 if it is not watched.
+ */
+int child_find(info_t *info_struct, pid_t pid)
+{
+	int index, found = -1;
+
+	for (index = 0; index < info_struct->child_count; index++)
+	{
+		if (info_struct->children[index].pid != pid && pid != -1)
+			continue;
+		found = index;
+		if (info_struct->children[index].done)
+			break;
+	}
+	return (found);
+}
+
+/**
+ * child_event - Handles one event of the child event loop.
+ * @info_struct: Pointer to the info_t structure.
+ * @event: The event returned by epoll_wait().
+ */
+void child_event(info_t *info_struct, struct epoll_event *event)
+{
+	unsigned long expirations;
+	char drain[64];
+	int index;
+
+	if (event->data.u64 == CHILD_TIMER)
+	{
+		COUNT_SYSCALL(SC_READ);
+		read(info_struct->timer_fd, &expirations, sizeof(expirations));
+		return;
+	}
+	if (event->data.u64 == CHILD_SIGCHLD) /* check children without pidfd */
+	{
+		COUNT_SYSCALL(SC_READ);
+		while (read(sigchld_pipe()[0], drain, sizeof(drain)) > 0)
+			;
+		for (index = 0; index < info_struct->child_count; index++)
+			if (info_struct->children[index].pidfd == -1)
+				child_reap(&info_struct->children[index]);
+		return;
+	}
+	index = child_find(info_struct, (pid_t)event->data.u64);
+	if (index >= 0)
+		child_reap(&info_struct->children[index]);
+}
@@ -0,0 +1,119 @@
+#include "main.h"
+
+/**
+ * child_reap - Reaps a watched child if it has exited.
+ * @child: The child.
+ *
+ * Description: wait4() is given the child's own pid, never -1, so other
+ * children are left alone. The pidfd is closed once the child is reaped,
+ * which also takes it out of the epoll set.
+ */
+void child_reap(child_t *child)
+{
+	if (child->done)
+		return;
+	COUNT_SYSCALL(SC_WAIT);
+	if (wait4(child->pid, &child->status, WNOHANG, &child->usage) <= 0)
+		return;
+	child->done = 1;
+	if (child->pidfd != -1)
+	{
+		COUNT_SYSCALL(SC_CLOSE);
+		close(child->pidfd);
+		child->pidfd = -1;
+	}
+}
+
+/**
+ * sigchld_pipe - Returns the SIGCHLD self-pipe.
+ *
+ * Return: The read and write ends, -1 until sigchld_fallback() made it.
+ */
+int *sigchld_pipe(void)
+{
+	static int fds[2] = {-1, -1};
+
+	return (fds);
+}
+
+/**
+ * sigchld_handler - Writes a byte to the SIGCHLD self-pipe.
+ * @signal_num: Unused.
+ *
+ * Description: The pipe is non-blocking, so a full pipe, which already
+ * has a wakeup pending, drops the byte.
+ */
+void sigchld_handler(__attribute__((unused)) int signal_num)
+{
+	int saved_errno = errno;
+
+	write(sigchld_pipe()[1], "", 1);
+	errno = saved_errno;
+}
+
+/**
+ * sigchld_fallback - Watches the newest child through SIGCHLD instead.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The self-pipe and its handler are set up once per process
+ * and added to the epoll set of every event loop that needs them. The
+ * child is checked once right away, in case it exited before the handler
+ * was in place.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int sigchld_fallback(info_t *info_struct)
+{
+	struct sigaction action;
+	struct epoll_event event;
+	child_t *child = &info_struct->children[info_struct->child_count - 1];
+	int *fds = sigchld_pipe(), index;
+
+	if (child->pidfd != -1)
+		close(child->pidfd), child->pidfd = -1;
+	COUNT_SYSCALL(SC_EVENT);
+	if (fds[0] == -1 && pipe(fds) == 0)
+	{
+		for (index = 0; index < 2; index++)
+			fcntl(fds[index], F_SETFL, O_NONBLOCK),
+				fcntl(fds[index], F_SETFD, FD_CLOEXEC);
+		_memset((char *)&action, 0, sizeof(action));
+		action.sa_handler = sigchld_handler;
+		action.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+		COUNT_SYSCALL(SC_SIGACTION);
+		sigaction(SIGCHLD, &action, NULL);
+	}
+	event.events = EPOLLIN;
+	event.data.u64 = CHILD_SIGCHLD;
+	COUNT_SYSCALL(SC_EVENT);
+	if (fds[0] == -1 || (epoll_ctl(info_struct->epoll_fd, EPOLL_CTL_ADD,
+				fds[0], &event) == -1 && errno != EEXIST))
+	{
+		info_struct->child_count--;
+		return (-1);
+	}
+	child_reap(child);
+	return (0);
+}
+
+/**
+ * child_loop_free - Releases the child event loop.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: Children still watched are not waited for.
+ */
+void child_loop_free(info_t *info_struct)
+{
+	int index;
+
+	for (index = 0; index < info_struct->child_count; index++)
+		if (info_struct->children[index].pidfd != -1)
+			close(info_struct->children[index].pidfd);
+	free_ptr((void **)&info_struct->children);
+	info_struct->child_count = info_struct->child_max = 0;
+	if (info_struct->epoll_fd != -1)
+		close(info_struct->epoll_fd);
+	if (info_struct->timer_fd != -1)
+		close(info_struct->timer_fd);
+	info_struct->epoll_fd = info_struct->timer_fd = -1;
+}
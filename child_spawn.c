@@ -0,0 +1,104 @@
+#include "main.h"
+
+/**
+ * fork_child - Forks and executes the current command.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Description: The child execs info_struct->path with info_struct->argv;
+ * should execve() fail, exec_failed() reports why. The caller is left to
+ * wait for it.
+ *
+ * Return: The process id of the child, or -1 if fork() failed.
+ */
+pid_t fork_child(info_t *info_struct)
+{
+	pid_t child_process_pid;
+
+	COUNT_SYSCALL(SC_FORK);
+	child_process_pid = fork();
+	if (child_process_pid == -1)
+	{
+		perror("Error:"); /* Print error message */
+		return (-1);
+	}
+
+	if (child_process_pid == 0) /* Child process */
+	{
+		execve(info_struct->path, info_struct->argv,
+				get_environ(info_struct));
+		exec_failed(info_struct, info_struct->argv[0]);
+	}
+	USDT_PROBE2(spawn, info_struct->path, child_process_pid);
+	return (child_process_pid);
+}
+
+/**
+ * fork_wait - Forks and executes the current command, and waits for it.
+ * @info_struct: Pointer to the info structure.
+ * @usage: Where to store the resource usage of the command.
+ *
+ * Description: The child is started by fork_child(). The parent hands it
+ * to the child event loop and waits for that child only, leaving its wait
+ * status in info_struct->status. Should the loop be unavailable, it falls
+ * back to wait4() on the child's pid.
+ *
+ * Return: The process id of the child, or -1 if fork() failed.
+ */
+pid_t fork_wait(info_t *info_struct, struct rusage *usage)
+{
+	pid_t child_process_pid = fork_child(info_struct);
+	child_t child;
+
+	if (child_process_pid == -1)
+		return (-1);
+	if (child_watch(info_struct, child_process_pid) == 0
+			&& child_wait(info_struct, child_process_pid, 0, &child) == 0)
+	{
+		info_struct->status = child.status;
+		*usage = child.usage;
+		return (child_process_pid);
+	}
+	COUNT_SYSCALL(SC_WAIT);
+	wait4(child_process_pid, &(info_struct->status), 0, usage);
+	return (child_process_pid);
+}
+
+/**
+ * exec_failed - Reports a failed execve() in the child and exits.
+ * @info_struct: Pointer to the info structure.
+ * @name: The command as it was typed.
+ *
+ * Description: Only the child knows errno, so it prints the error itself
+ * and exits with the status exec_status() maps it to.
+ */
+void exec_failed(info_t *info_struct, char *name)
+{
+	int error = errno;
+
+	print_string(info_struct->fname);
+	print_string(": ");
+	print_decimal(info_struct->line_count, STDERR_FILENO);
+	print_string(": ");
+	print_string(name);
+	print_string(": ");
+	print_string(strerror(error));
+	print_char('\n');
+	print_char(BUF_FLUSH);
+	_exit(exec_status(error));
+}
+
+/**
+ * exec_status - Maps a failed execve() to an exit status.
+ * @error: The errno left by execve().
+ *
+ * Description: Every path that executes a command, forked or in place,
+ * fails with this status. Like coreutils and POSIX shells, a program that
+ * is missing gives 127 and one that exists but cannot be executed 126,
+ * whatever the reason.
+ *
+ * Return: 127 or 126.
+ */
+int exec_status(int error)
+{
+	return (error == ENOENT || error == ENOTDIR ? 127 : 126);
+}
@@ -56,6 +56,7 @@ int write_history_to_file(info_t *info_struct)
 	if (!file_name)
 		return (-1);
 
+	COUNT_SYSCALL(SC_OPEN);
 	file_desc = open(file_name, O_CREAT | O_TRUNC | O_RDWR, 0644);
 	free(file_name);
 	if (file_desc == -1)
@@ -69,7 +70,9 @@ int write_history_to_file(info_t *info_struct)
 
 	/* Flush the buffer to the file */
 	print_char_file_desc(BUF_FLUSH, file_desc);
+	COUNT_SYSCALL(SC_CLOSE);
 	close(file_desc);
+	USDT_PROBE1(history_write, info_struct->histcount);
 
 	return (1); /* Return 1 on success */
 }
@@ -82,10 +85,12 @@ int write_history_to_file(info_t *info_struct)
  *
  * Description: This function reads command history from a file specified by
  * history file path stored in info_struct structure. It reads the file line
- * by line, populating the history linked list with each command. The function
- * returns the number of history entries read. If an error occurs, or if the
- * history file is empty or inaccessible, the function returns 0 to
- * indicate failure.
+ * by line, populating the history linked list with each command. Only the
+ * lines that fit in HIST_MAX are parsed, and each one is appended after the
+ * previous node, so loading stays linear in the size of the file. The
+ * function returns the number of history entries read. If an error occurs,
+ * or if the history file is empty or inaccessible, the function returns 0
+ * to indicate failure.
  */
 int read_command_history(info_t *info_struct)
 {
@@ -93,13 +98,16 @@ int read_command_history(info_t *info_struct)
 	int count, last_count = 0, num_line_count = 0;
 	ssize_t file_desc, read_len, file_size = 0;
 	char *buffer = NULL, *filename = generate_history_filepath(info_struct);
+	info_list *tail = NULL;
 
 	if (!filename)
 		return (0);
+	COUNT_SYSCALL(SC_OPEN);
 	file_desc = open(filename, O_RDONLY);
 	free(filename);
 	if (file_desc == -1)
 		return (0);
+	COUNT_SYSCALL(SC_FSTAT);
 	if (!fstat(file_desc, &env_stat))
 		file_size = env_stat.st_size;
 	if (file_size < 2)
@@ -107,24 +115,26 @@ int read_command_history(info_t *info_struct)
 	buffer = malloc(sizeof(char) * (file_size + 1));
 	if (!buffer)
 		return (0);
+	COUNT_SYSCALL(SC_READ);
 	read_len = read(file_desc, buffer, file_size);
 	buffer[file_size] = 0;
 	if (read_len <= 0)
 		return (free(buffer), 0);
+	COUNT_SYSCALL(SC_CLOSE);
 	close(file_desc);
-	for (count = 0; count < file_size; count++)
+	for (count = last_count = history_start(buffer, file_size);
+			count < file_size; count++)
 		if (buffer[count] == '\n')
 		{
 			buffer[count] = 0;
-			add_to_history_list(info_struct, buffer + last_count, num_line_count++);
+			tail = add_node_end(tail ? &tail : &(info_struct->history),
+					buffer + last_count, num_line_count++);
 			last_count = count + 1;
 		}
 	if (last_count != count)
-		add_to_history_list(info_struct, buffer + last_count, num_line_count++);
+		add_node_end(tail ? &tail : &(info_struct->history),
+				buffer + last_count, num_line_count++);
 	free(buffer);
-	info_struct->histcount = num_line_count;
-	while (info_struct->histcount-- >= HIST_MAX)
-		delete_node_at_index(&(info_struct->history), 0);
 	add_numbering_to_history(info_struct);
 	return (info_struct->histcount);
 }
@@ -183,5 +193,3 @@ int add_numbering_to_history(info_t *info_struct)
 	/* Update and return the number of history entries */
 	return (info_struct->histcount = count);
 }
-
-
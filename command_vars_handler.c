@@ -141,8 +141,11 @@ int replace_cmd_with_alias(info_t *info_struct)
  * Description:
  * This function iterates through the command arguments in info_struct->argv
  * and replaces any variables (e.g., $?, $$, $VAR) with their corresponding
- * values. It checks for the special variables $? (status), $$ (process ID),
- * and user-defined environment variables.
+ * values. It checks for the special variables $? (status), $$ (cached
+ * process ID),
+ * and user-defined environment variables. Words whose '$' was single-quoted
+ * or escaped are left alone. An environment variable may be followed by
+ * other text, see replace_env_var().
  *
  * Return:
  * Always returns 0.
@@ -150,11 +153,12 @@ int replace_cmd_with_alias(info_t *info_struct)
 int replace_cmd_argv(info_t *info_struct)
 {
 	int count = 0;
-	info_list *node;
 
 	for (count = 0; info_struct->argv[count]; count++)
 	{
-		if (info_struct->argv[count][0] != '$' || !info_struct->argv[count][1])
+		if (info_struct->argv[count][0] != '$' || !info_struct->argv[count][1]
+				|| (info_struct->argq
+					&& info_struct->argq[count] & QUOTE_NOVAR))
 			continue;
 
 		if (!_strcmp(info_struct->argv[count], "$?"))
@@ -166,17 +170,13 @@ int replace_cmd_argv(info_t *info_struct)
 		if (!_strcmp(info_struct->argv[count], "$$"))
 		{
 			replace_string(&(info_struct->argv[count]),
-					_strdup(num_str_converter(getpid(), 10, 0)));
+					_strdup(num_str_converter(shell_pid(info_struct), 10, 0)));
 			continue;
 		}
-		node = node_starts_with(info_struct->env, &info_struct->argv[count][1], '=');
-		if (node)
-		{
-			replace_string(&(info_struct->argv[count]),
-					_strdup(_strchr(node->str, '=') + 1));
+		if (replace_positional(info_struct, count)
+				|| replace_usage_var(info_struct, count))
 			continue;
-		}
-		replace_string(&info_struct->argv[count], _strdup(""));
+		replace_env_var(info_struct, count);
 	}
 	return (0);
 }
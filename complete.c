@@ -0,0 +1,186 @@
+#include "main.h"
+
+/**
+ * complete_line - Completes the word before the cursor.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ *
+ * Description: The first word of a command is completed from the builtins,
+ * aliases, functions and commands in PATH; other words, and any word
+ * holding a '/', from the file system. The word is unquoted before it is
+ * matched, so "my\ fi" completes the same as "my fi" would.
+ */
+void complete_line(info_t *info_struct, line_edit_t *ed)
+{
+	glob_res_t res = {NULL, 0, 0};
+	size_t start = ed->pos, cmd_pos;
+	char *word, *base;
+
+	while (start && !(is_delimiter(ed->buf[start - 1], " \t;&|")
+				&& (start < 2 || ed->buf[start - 2] != '\\')))
+		start--;
+	for (cmd_pos = start; cmd_pos
+			&& is_delimiter(ed->buf[cmd_pos - 1], " \t");)
+		cmd_pos--;
+	word = _strdup(ed->buf + start);
+	if (!word)
+		return;
+	word[ed->pos - start] = '\0';
+	unquote_word(word, NULL);
+	for (base = word + _strlen(word); base > word && base[-1] != '/';)
+		base--;
+	if (base > word
+			|| (cmd_pos && !is_delimiter(ed->buf[cmd_pos - 1], ";&|")))
+		complete_files(word, &res);
+	else
+		complete_cmds(info_struct, word, &res);
+	complete_apply(ed, base, &res);
+	free_ptr_array(res.strs);
+	free(word);
+}
+
+/**
+ * complete_cmds - Collects the command names starting with a prefix.
+ * @info_struct: Pointer to the info_t structure.
+ * @prefix: The prefix.
+ * @res: Where to append the names.
+ */
+void complete_cmds(info_t *info_struct, char *prefix, glob_res_t *res)
+{
+	builtin_table *builtins = builtin_list();
+	info_list *node;
+	shell_func_t *func;
+	char *equal;
+	int index;
+
+	for (index = 0; builtins[index].type; index++)
+		if (starts_with(builtins[index].type, prefix))
+			glob_add(res, builtins[index].type, "");
+	for (node = info_struct->alias; node; node = node->next)
+	{
+		equal = _strchr(node->str, '=');
+		if (!equal)
+			continue;
+		*equal = '\0';
+		if (starts_with(node->str, prefix))
+			glob_add(res, node->str, "");
+		*equal = '=';
+	}
+	for (index = 0; info_struct->functions && index < FUNC_TABLE_SIZE; index++)
+		for (func = info_struct->functions[index]; func; func = func->next)
+			if (starts_with(func->name, prefix))
+				glob_add(res, func->name, "");
+	if (comp_refresh(info_struct))
+		comp_search(info_struct->completion, prefix, res);
+}
+
+/**
+ * complete_files - Collects the file names completing a path.
+ * @path: The path typed so far.
+ * @res: Where to append the last component of each match, with a '/'
+ * added to directories.
+ *
+ * Description: Names starting with '.' are only offered when the last
+ * component does too.
+ */
+void complete_files(char *path, glob_res_t *res)
+{
+	glob_dir_t *cache = NULL, *dir;
+	char *base = path + _strlen(path), *dir_path, *name, *full;
+	struct stat st;
+	int index;
+
+	while (base > path && base[-1] != '/')
+		base--;
+	dir_path = _strdup(path);
+	if (!dir_path)
+		return;
+	dir_path[base - path] = '\0';
+	dir = glob_list(&cache, dir_path);
+	for (index = 0; dir && index < dir->count; index++)
+	{
+		name = dir->names + dir->offsets[index];
+		if (!starts_with(name, base) || (*name == '.' && *base != '.'))
+			continue;
+		full = malloc(_strlen(dir_path) + _strlen(name) + 1);
+		if (!full)
+			break;
+		_strcat(_strcpy(full, dir_path), name);
+		glob_add(res, name, stat(full, &st) == 0 && S_ISDIR(st.st_mode)
+				? "/" : "");
+		free(full);
+	}
+	glob_cache_free(cache);
+	free(dir_path);
+}
+
+/**
+ * complete_apply - Puts the result of a completion on the line.
+ * @ed: The line being edited.
+ * @typed: The unquoted part of the word the candidates complete.
+ * @res: The candidates.
+ *
+ * Description: The part all candidates share is inserted, escaped so the
+ * lexer reads it back unchanged. A single candidate is followed by a
+ * blank, unless it is a directory. When nothing could be inserted, the
+ * candidates are listed; when there are none, the terminal bell rings.
+ */
+void complete_apply(line_edit_t *ed, char *typed, glob_res_t *res)
+{
+	size_t common, len = _strlen(typed), pos;
+	int index;
+	char *first;
+
+	if (!res->count)
+	{
+		edit_out(ed, "\a", 1);
+		return;
+	}
+	qsort(res->strs, res->count, sizeof(char *), glob_cmp);
+	first = res->strs[0];
+	common = _strlen(first);
+	for (index = 1; index < res->count; index++)
+		for (pos = 0; pos < common; pos++)
+			if (first[pos] != res->strs[index][pos])
+				common = pos;
+	for (pos = len; pos < common; pos++)
+	{
+		if (_strchr(" \t\n'\"\\$*?[;&|#<>()`", first[pos]))
+			edit_insert(ed, "\\", 1);
+		edit_insert(ed, first + pos, 1);
+	}
+	if (_strcmp(first, res->strs[res->count - 1]) == 0)
+	{
+		if (first[common - 1] != '/')
+			edit_insert(ed, " ", 1);
+	}
+	else if (common == len)
+		complete_list(ed, res);
+}
+
+/**
+ * complete_list - Lists the candidates of a completion below the line.
+ * @ed: The line being edited.
+ * @res: The candidates, sorted.
+ *
+ * Description: Each candidate is listed once. The terminal line is then
+ * taken as empty, so edit_redraw() draws the prompt and the line again.
+ */
+void complete_list(line_edit_t *ed, glob_res_t *res)
+{
+	int index;
+
+	edit_out(ed, "\n", 1);
+	for (index = 0; index < res->count; index++)
+	{
+		if (index && _strcmp(res->strs[index], res->strs[index - 1]) == 0)
+			continue;
+		if (index)
+			edit_out(ed, "  ", 2);
+		edit_out(ed, res->strs[index], _strlen(res->strs[index]));
+	}
+	edit_out(ed, "\n", 1);
+	free(ed->shown);
+	ed->shown = NULL;
+	ed->col = 0;
+}
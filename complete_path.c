@@ -0,0 +1,153 @@
+#include "main.h"
+
+/**
+ * comp_refresh - Brings the command names of PATH up to date.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The names are gathered lazily, on the first completion of
+ * a command. After that each PATH directory is only read again when its
+ * mtime changed, and all listings are dropped when PATH itself changes.
+ * Empty entries of PATH are skipped, since the working directory moves.
+ *
+ * Return: The cache, or NULL on failure.
+ */
+comp_cache_t *comp_refresh(info_t *info_struct)
+{
+	comp_cache_t *cache = info_struct->completion;
+	char *path = get_env_var(info_struct, "PATH="), dir[PATH_MAX];
+	size_t start, end;
+	int changed = 0;
+
+	if (!cache)
+	{
+		cache = malloc(sizeof(*cache));
+		if (!cache)
+			return (NULL);
+		_memset((char *)cache, 0, sizeof(*cache));
+		info_struct->completion = cache;
+	}
+	path = path ? path : "";
+	if (!cache->path || _strcmp(cache->path, path))
+	{
+		glob_cache_free(cache->dirs);
+		cache->dirs = NULL;
+		free(cache->path);
+		cache->path = _strdup(path);
+		changed = 1;
+	}
+	for (start = 0; path[start]; start = end + !!path[end])
+	{
+		for (end = start; path[end] && path[end] != ':'; end++)
+			;
+		if (end == start || end - start >= PATH_MAX)
+			continue;
+		_strncpy(dir, path + start, end - start + 1);
+		changed |= comp_read_dir(cache, dir);
+	}
+	if (changed)
+		comp_rebuild(cache);
+	return (cache);
+}
+
+/**
+ * comp_read_dir - Reads a PATH directory again if it changed.
+ * @cache: The completion cache.
+ * @path: The directory.
+ *
+ * Return: 1 if the listing of @path was (re)read, 0 if it was current.
+ */
+int comp_read_dir(comp_cache_t *cache, char *path)
+{
+	glob_dir_t **link, *dir;
+	struct stat st;
+	unsigned long mtime = 0;
+
+	COUNT_SYSCALL(SC_STAT);
+	if (stat(path, &st) == 0)
+		mtime = st.st_mtim.tv_sec * 1000000000UL + st.st_mtim.tv_nsec;
+	for (link = &cache->dirs; *link; link = &((*link)->next))
+		if (_strcmp((*link)->path, path) == 0)
+			break;
+	dir = *link;
+	if (dir && dir->mtime == mtime)
+		return (0);
+	if (dir)
+	{
+		*link = dir->next;
+		dir->next = NULL;
+		glob_cache_free(dir);
+	}
+	glob_list(&cache->dirs, path);
+	if (cache->dirs && _strcmp(cache->dirs->path, path) == 0)
+		cache->dirs->mtime = mtime;
+	return (1);
+}
+
+/**
+ * comp_rebuild - Merges the PATH listings into one sorted name array.
+ * @cache: The completion cache.
+ */
+void comp_rebuild(comp_cache_t *cache)
+{
+	glob_dir_t *dir;
+	int total = 0, index, kept;
+
+	free(cache->names);
+	cache->names = NULL;
+	cache->count = 0;
+	for (dir = cache->dirs; dir; dir = dir->next)
+		total += dir->names ? dir->count : 0;
+	cache->names = malloc(sizeof(char *) * (total + 1));
+	if (!cache->names)
+		return;
+	for (dir = cache->dirs; dir; dir = dir->next)
+		for (index = 0; dir->names && index < dir->count; index++)
+			cache->names[cache->count++] = dir->names + dir->offsets[index];
+	qsort(cache->names, cache->count, sizeof(char *), glob_cmp);
+	for (index = 0, kept = 0; index < cache->count; index++)
+		if (!kept || _strcmp(cache->names[kept - 1], cache->names[index]))
+			cache->names[kept++] = cache->names[index];
+	cache->count = kept;
+}
+
+/**
+ * comp_search - Collects the PATH commands starting with a prefix.
+ * @cache: The completion cache.
+ * @prefix: The prefix.
+ * @res: Where to append the names.
+ *
+ * Description: The names starting with @prefix are next to each other in
+ * the sorted array, so a binary search finds the first one.
+ */
+void comp_search(comp_cache_t *cache, char *prefix, glob_res_t *res)
+{
+	int low = 0, high = cache->count, mid;
+
+	while (low < high)
+	{
+		mid = low + (high - low) / 2;
+		if (_strcmp(cache->names[mid], prefix) < 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	for (; low < cache->count && starts_with(cache->names[low], prefix); low++)
+		glob_add(res, cache->names[low], "");
+}
+
+/**
+ * comp_free - Frees the completion cache.
+ * @info_struct: Pointer to the info_t structure.
+ */
+void comp_free(info_t *info_struct)
+{
+	comp_cache_t *cache = info_struct->completion;
+
+	if (!cache)
+		return;
+	free(cache->path);
+	glob_cache_free(cache->dirs);
+	free(cache->names);
+	free(cache);
+	info_struct->completion = NULL;
+}
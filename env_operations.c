@@ -12,15 +12,20 @@
  * 'environ' is not yet populated, the function converts the linked list of
  * environment variables into an array of strings using the
  * 'linked_list_to_strings' function.
- * The 'env_changed' flag is then reset. The resulting array is
- * returned.
+ * The 'env_changed' flag is then reset, as is the cached size of the
+ * array kept for run_batches(). The resulting array is
+ * returned. While the list has not been built the process 'environ' is
+ * returned as is.
  */
 char **get_environ(info_t *info_struct)
 {
+	if (!info_struct->env_ready) /* untouched: pass environ through */
+		return (environ);
 	if (!info_struct->environ || info_struct->env_changed)
 	{
 		info_struct->environ = linked_list_to_strings(info_struct->env);
 		info_struct->env_changed = 0;
+		info_struct->env_bytes = 0;
 	}
 
 	return (info_struct->environ);
@@ -44,7 +49,7 @@ char **get_environ(info_t *info_struct)
  */
 int _unset_env(info_t *info_struct, char *char_var)
 {
-	info_list *current_node = info_struct->env;
+	info_list *current_node = get_env_list(info_struct);
 	size_t count = 0;
 	char *char_ptr;
 
@@ -107,7 +112,7 @@ int _setenv(info_t *info_struct, char *char_var, char *value)
 	_strcat(buffer, "=");
 	_strcat(buffer, value);
 
-	node_cursor = info_struct->env;
+	node_cursor = get_env_list(info_struct);
 	while (node_cursor)
 	{
 		start_char = starts_with(node_cursor->str, char_var);
@@ -127,3 +132,21 @@ int _setenv(info_t *info_struct, char *char_var, char *value)
 	return (0);
 }
 
+
+/**
+ * get_env_list - Returns the environment list, building it on first use.
+ * @info_struct: Pointer to the information structure.
+ *
+ * Description: Non-interactive shells do not build the environment list at
+ * startup. Anything that needs the list itself, rather than a single value,
+ * goes through this function.
+ *
+ * Return: Head of the environment list.
+ */
+info_list *get_env_list(info_t *info_struct)
+{
+	if (!info_struct->env_ready)
+		initialize_env_list(info_struct);
+
+	return (info_struct->env);
+}
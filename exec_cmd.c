@@ -0,0 +1,141 @@
+#include "main.h"
+
+/**
+ * input_at_eof - Checks whether the shell input has been fully consumed.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: A "-c" string is exhausted once nothing is left of it. For a
+ * file descriptor, no buffered bytes may remain and the descriptor must be
+ * a regular file whose offset has reached its size. Pipes and terminals
+ * cannot be checked without reading, so they never count as being at EOF.
+ *
+ * Return: 1 if no further input can follow, 0 otherwise.
+ */
+int input_at_eof(info_t *info_struct)
+{
+	struct stat stat_struct;
+	off_t offset;
+
+	if (info_struct->cmd_str)
+		return (!*info_struct->cmd_str);
+
+	if (info_struct->read_pending)
+		return (0);
+	COUNT_SYSCALL(SC_FSTAT);
+	if (fstat(info_struct->readfd, &stat_struct) != 0
+			|| !S_ISREG(stat_struct.st_mode))
+		return (0);
+
+	COUNT_SYSCALL(SC_LSEEK);
+	offset = lseek(info_struct->readfd, 0, SEEK_CUR);
+	return (offset != -1 && offset >= stat_struct.st_size);
+}
+
+/**
+ * is_last_cmd - Checks whether the current command is the last one to run.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Return: 1 if the shell is non-interactive, outside of any function or
+ * timed command, has no chained command pending and has reached the end
+ * of its input.
+ */
+int is_last_cmd(info_t *info_struct)
+{
+	return (!is_interactive(info_struct) && !info_struct->func_depth
+			&& !info_struct->keep_shell && !info_struct->cmd_pending
+			&& input_at_eof(info_struct));
+}
+
+/**
+ * replace_shell - Replaces the shell process with a command.
+ * @info_struct: Pointer to the info_t structure.
+ * @path: Path of the program to execute.
+ * @argv: Argument vector of the program.
+ *
+ * Description: Pending output is flushed and, for an interactive session,
+ * the history saved first, since neither happens once the process image
+ * is gone. This function only returns if execve() fails.
+ */
+void replace_shell(info_t *info_struct, char *path, char **argv)
+{
+	if (is_interactive(info_struct))
+		write_history_to_file(info_struct);
+	_putchar(BUF_FLUSH);
+	print_char(BUF_FLUSH);
+	report_stats(info_struct);
+
+	COUNT_SYSCALL(SC_EXECVE);
+	execve(path, argv, get_environ(info_struct));
+}
+
+/**
+ * hsh_exec - Handles the exec builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: 0 when called without a command, otherwise -2 so the shell
+ * exits after a failed exec: with 127 if the command was not found, or
+ * with the status exec_status() gives the reported execve() error.
+ *
+ * Description: This function resolves the command like search_exe_cmd()
+ * does and replaces the shell with it, without forking. An embedded
+ * interpreter (hsh_new()) runs the command as a child instead and exits
+ * with its status, since the process belongs to its host.
+ */
+int hsh_exec(info_t *info_struct)
+{
+	char *path;
+	int error = 0;
+
+	if (info_struct->argc < 2)
+		return (0);
+
+	path = find_cmd_path(info_struct, get_env_var(info_struct, "PATH="),
+			info_struct->argv[1]);
+	if (!path && _strchr(info_struct->argv[1], '/')
+			&& is_exe_cmd(info_struct, info_struct->argv[1]))
+		path = info_struct->argv[1];
+	if (path && info_struct->embedded) /* keep the host: run it, then exit */
+	{
+		info_struct->argv++;
+		info_struct->path = path;
+		fork_execute_cmd(info_struct);
+		info_struct->argv--;
+		info_struct->err_num = info_struct->status;
+		return (-2);
+	}
+	if (path)
+	{
+		replace_shell(info_struct, path, info_struct->argv + 1);
+		error = errno;
+	}
+
+	info_struct->err_num = path ? exec_status(error) : 127;
+	print_error(info_struct, info_struct->argv[1]);
+	print_string(": ");
+	print_string(path ? strerror(error) : "not found");
+	print_char('\n');
+	print_char(BUF_FLUSH);
+	return (-2);
+}
+
+/**
+ * dispatch_rest - Runs the command that follows a prefix keyword.
+ * @info_struct: Pointer to the info structure.
+ * @shift: Number of words taken by the prefix and its options.
+ *
+ * Description: The prefix, such as "time", already counted the input
+ * line, so the command is not counted again and the errors it reports
+ * carry the line number they are on.
+ *
+ * Return: The result of dispatch_cmd().
+ */
+int dispatch_rest(info_t *info_struct, int shift)
+{
+	int result;
+
+	info_struct->argv += shift, info_struct->argc -= shift;
+	info_struct->linecount_flag = 0;
+	result = dispatch_cmd(info_struct);
+	info_struct->argv -= shift, info_struct->argc += shift;
+	return (result);
+}
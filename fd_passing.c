@@ -0,0 +1,157 @@
+#include "main.h"
+
+/**
+ * send_fds - Sends a header along with descriptors 0, 1 and 2.
+ * @sock: A connected Unix socket.
+ * @header: The bytes to send.
+ * @size: Size of @header.
+ *
+ * Description: The descriptors travel as SCM_RIGHTS ancillary data, so
+ * the receiver gets its own copies of the sender's stdin, stdout and
+ * stderr.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int send_fds(int sock, void *header, size_t size)
+{
+	char control[CMSG_SPACE(sizeof(int) * 3)];
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	int index;
+
+	_memset(control, 0, sizeof(control));
+	_memset((char *)&msg, 0, sizeof(msg));
+	iov.iov_base = header;
+	iov.iov_len = size;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int) * 3);
+	for (index = 0; index < 3; index++)
+		((int *)CMSG_DATA(cmsg))[index] = index;
+	COUNT_SYSCALL(SC_SOCKET);
+	if (sendmsg(sock, &msg, 0) != (ssize_t)size)
+		return (-1);
+	return (0);
+}
+
+/**
+ * recv_fds - Receives a header sent by send_fds().
+ * @sock: A connected Unix socket.
+ * @header: Where to store the header.
+ * @size: Size of @header.
+ * @fds: Where to store the three descriptors, close-on-exec.
+ *
+ * Description: Descriptors that came with a bad message are closed, since
+ * the kernel installs them whether or not they are wanted.
+ *
+ * Return: 0 on success, -1 on error, end-of-file, or a short header.
+ */
+int recv_fds(int sock, void *header, size_t size, int *fds)
+{
+	char control[CMSG_SPACE(sizeof(int) * 3)];
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	ssize_t got;
+	int index, *received;
+	size_t count = 0;
+
+	_memset((char *)&msg, 0, sizeof(msg));
+	iov.iov_base = header;
+	iov.iov_len = size;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+	COUNT_SYSCALL(SC_SOCKET);
+	got = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+	cmsg = got > 0 ? CMSG_FIRSTHDR(&msg) : NULL;
+	if (cmsg && cmsg->cmsg_level == SOL_SOCKET
+			&& cmsg->cmsg_type == SCM_RIGHTS)
+		count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+	received = count ? (int *)CMSG_DATA(cmsg) : NULL;
+	if (got != (ssize_t)size || count != 3 || msg.msg_flags & MSG_CTRUNC)
+	{
+		while (count--) /* installed already: do not leak them */
+			close(received[count]);
+		return (-1);
+	}
+	for (index = 0; index < 3; index++)
+		fds[index] = received[index];
+	return (0);
+}
+
+/**
+ * read_full - Reads exactly @len bytes.
+ * @fd: The descriptor to read from.
+ * @buffer: Destination.
+ * @len: Number of bytes wanted.
+ *
+ * Return: 0 on success, -1 on error or early end-of-file.
+ */
+int read_full(int fd, char *buffer, size_t len)
+{
+	ssize_t got;
+
+	while (len)
+	{
+		COUNT_SYSCALL(SC_READ);
+		got = read(fd, buffer, len);
+		if (got <= 0)
+			return (-1);
+		buffer += got;
+		len -= got;
+	}
+	return (0);
+}
+
+/**
+ * write_full - Writes exactly @len bytes.
+ * @fd: The descriptor to write to.
+ * @buffer: Source.
+ * @len: Number of bytes to write.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int write_full(int fd, char *buffer, size_t len)
+{
+	ssize_t sent;
+
+	while (len)
+	{
+		COUNT_SYSCALL(SC_WRITE);
+		sent = write(fd, buffer, len);
+		if (sent <= 0)
+			return (-1);
+		buffer += sent;
+		len -= sent;
+	}
+	return (0);
+}
+
+/**
+ * recv_request - Receives a request header and the client's descriptors.
+ * @conn: The client connection.
+ * @req: Where to store the header.
+ * @fds: Where to store the client's stdin, stdout and stderr.
+ *
+ * Return: 0 on success, -1 on a short or malformed header.
+ */
+int recv_request(int conn, serve_req_t *req, int *fds)
+{
+	if (recv_fds(conn, req, sizeof(*req), fds) == -1)
+		return (-1);
+	if (req->magic != SERVE_MAGIC || req->cmd_len > SERVE_FIELD_MAX
+			|| req->env_len > SERVE_FIELD_MAX || req->cwd_len > SERVE_FIELD_MAX)
+	{
+		close(fds[0]), close(fds[1]), close(fds[2]);
+		return (-1);
+	}
+	return (0);
+}
@@ -83,13 +83,12 @@ void print_error(info_t *info_struct, char *str_error)
  * lowercase hexadecimal characters. The function performs the conversion by
  * iteratively dividing the number by the base and building the string
  * representation.
- * The resulting string is stored in the 'buffer' array, and a pointer to the
- * beginning of the string is returned.
+ * The resulting string is stored in the num_buf of the current interpreter
+ * (shell_ctx()), and a pointer to the beginning of the string is returned.
  */
 char *num_str_converter(long int num, int base, int flags)
 {
-	static char *array_char;
-	static char buffer[50];
+	char *array_char, *buffer = shell_ctx()->io.num_buf;
 	char sign_char = 0;
 	char *ptr_str;
 	unsigned long num_to_convert = num;
@@ -124,7 +123,8 @@ char *num_str_converter(long int num, int base, int flags)
  *
  * Description: This function removes comments from the provided string.
  * It iterates through the characters of the string and looks for '#' char
- * that are either at the beginning of the line or preceded by a space.
+ * that are either at the beginning of the line or preceded by a space,
+ * skipping over quoted text.
  * When a '#' is found meeting these conditions, the rest of the line is
  * truncated, effectively removing the comment. The function modifies
  * the original string in place.
@@ -135,7 +135,9 @@ void remove_comments(char *buf)
 
 	for (count = 0; buf[count] != '\0'; count++)
 	{
-		if (buf[count] == '#' && (!count || buf[count - 1] == ' '))
+		if (quote_end(buf, count) != (size_t)count)
+			count = quote_end(buf, count);
+		else if (buf[count] == '#' && (!count || buf[count - 1] == ' '))
 		{
 			buf[count] = '\0'; /* Truncate the string at the comment */
 			break;
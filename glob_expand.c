@@ -0,0 +1,186 @@
+#include "main.h"
+
+/**
+ * expand_globs - Expands the pathname patterns among the arguments.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: Runs after replace_cmd_argv(). Every argument holding an
+ * unquoted '*', '?' or '[' is replaced by the paths it matches, in
+ * bytewise order, or kept as it is if nothing matches. Quoted wildcards
+ * arrive escaped with a '\', see unquote_word(), and match literally.
+ * Directories are read at most once per command, however many patterns
+ * look into them. Should memory run out, the error is reported and argv
+ * is left NULL, so that the command is not run with some of its arguments
+ * missing.
+ *
+ * Return: The number of patterns that matched, or -1 on failure.
+ */
+int expand_globs(info_t *info_struct)
+{
+	glob_dir_t *cache = NULL;
+	glob_res_t res = {NULL, 0, 0};
+	char **argv = info_struct->argv;
+	int index, before, expanded = 0;
+
+	for (index = 0; argv && argv[index] && !is_glob_arg(info_struct, index);)
+		index++;
+	if (!argv || !argv[index])
+		return (0);
+	for (index = 0; argv[index]; index++)
+	{
+		before = res.count;
+		if (is_glob_arg(info_struct, index) && glob_walk(&cache,
+					*argv[index] == '/' ? "/" : "",
+					argv[index] + (*argv[index] == '/'), &res) == -1)
+			break;
+		if (res.count > before)
+			qsort(res.strs + before, res.count - before, sizeof(char *),
+					glob_cmp), free(argv[index]), expanded++;
+		else if (glob_add(&res, info_struct->argq && info_struct->argq[index]
+					& QUOTE_PATTERN ? glob_unescape(argv[index]) : argv[index],
+					NULL) == -1)
+			break;
+	}
+	glob_cache_free(cache);
+	if (argv[index]) /* out of memory: run nothing rather than a part */
+	{
+		info_struct->argv = argv + index; /* names the failed argument */
+		info_struct->line_count += info_struct->linecount_flag == 1;
+		info_struct->linecount_flag = 0, info_struct->status = 2;
+		print_error(info_struct, "out of memory\n");
+		while (argv[index])
+			free(argv[index++]);
+		free_ptr_array(res.strs), res.strs = NULL, res.count = 0;
+	}
+	free(argv);
+	info_struct->argv = res.strs;
+	info_struct->argc = res.count;
+	return (res.strs ? expanded : -1);
+}
+
+/**
+ * is_glob_arg - Checks whether an argument is a pattern to expand.
+ * @info_struct: Pointer to the info_t structure.
+ * @index: Index of the argument in argv.
+ *
+ * Return: 1 if the argument has an unquoted wildcard, else 0.
+ */
+int is_glob_arg(info_t *info_struct, int index)
+{
+	char *arg = info_struct->argv[index];
+
+	if (info_struct->argq && info_struct->argq[index] & QUOTE_NOGLOB)
+		return (0);
+	return (has_glob(arg, _strlen(arg)));
+}
+
+/**
+ * glob_walk - Matches the rest of a pattern below a directory.
+ * @cache: The directory cache of the command.
+ * @prefix: The directory reached so far, "" or ending in '/'.
+ * @pat: The components of the pattern left, separated by '/'.
+ * @res: Where to append the matches.
+ *
+ * Description: Components without wildcards are taken as they are, less
+ * their escapes, so only directories that a wildcard has to look into are
+ * listed. A pattern ending in '/' matches directories only. Names
+ * starting with '.' are only matched by a component that starts with one.
+ *
+ * Return: 0 on success, -1 if memory ran out.
+ */
+int glob_walk(glob_dir_t **cache, char *prefix, char *pat, glob_res_t *res)
+{
+	char *slash = _strchr(pat, '/'), *path, *name;
+	glob_dir_t *dir;
+	int index, result = 0;
+	struct stat st;
+
+	if (slash)
+		*slash = '\0';
+	if (!has_glob(pat, _strlen(pat)))
+		dir = NULL;
+	else
+		dir = glob_list(cache, prefix);
+	for (index = 0; !result && (!dir || index < dir->count); index++)
+	{
+		name = dir ? dir->names + dir->offsets[index] : pat;
+		if (dir && ((*name == '.' && *pat != '.') || !glob_match(pat, name)))
+			continue;
+		path = malloc(_strlen(prefix) + _strlen(name) + 2);
+		if (!path)
+		{
+			result = -1;
+			break;
+		}
+		_strcat(_strcpy(path, prefix), name);
+		if (!dir)
+			glob_unescape(path + _strlen(prefix));
+		if (slash && slash[1])
+			result = glob_walk(cache, _strcat(path, "/"), slash + 1, res);
+		else if (!slash && (dir || lstat(path, &st) == 0))
+			result = glob_add(res, path, "");
+		else if (slash && stat(path, &st) == 0 && S_ISDIR(st.st_mode))
+			result = glob_add(res, path, "/");
+		free(path);
+		if (!dir)
+			break;
+	}
+	if (slash)
+		*slash = '/';
+	return (result);
+}
+
+/**
+ * has_glob - Checks whether a word holds an unescaped wildcard.
+ * @word: The word.
+ * @len: Its length.
+ *
+ * Return: 1 if @word has a '*', '?' or '[' not preceded by a '\', else 0.
+ */
+int has_glob(char *word, size_t len)
+{
+	size_t index;
+
+	for (index = 0; index < len; index++)
+	{
+		if (word[index] == '\\')
+			index++;
+		else if (word[index] == '*' || word[index] == '?'
+				|| word[index] == '[')
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * glob_add - Appends a string to a result list.
+ * @res: The list, kept NULL-terminated.
+ * @str: The string.
+ * @suffix: NULL to append @str itself, or text to append to a copy of it.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int glob_add(glob_res_t *res, char *str, char *suffix)
+{
+	char **strs, *copy;
+
+	if (res->count + 1 >= res->max)
+	{
+		strs = _realloc(res->strs, sizeof(char *) * res->max,
+				sizeof(char *) * (res->max * 2 + 8));
+		if (!strs)
+			return (-1);
+		res->strs = strs;
+		res->max = res->max * 2 + 8;
+	}
+	if (suffix)
+	{
+		copy = malloc(_strlen(str) + _strlen(suffix) + 1);
+		if (!copy)
+			return (-1);
+		str = _strcat(_strcpy(copy, str), suffix);
+	}
+	res->strs[res->count++] = str;
+	res->strs[res->count] = NULL;
+	return (0);
+}
@@ -0,0 +1,171 @@
+#include "main.h"
+
+/**
+ * glob_match - Matches a name against one pattern component.
+ * @pat: The pattern: '*', '?', '[...]' and '\' escapes, no '/'.
+ * @name: The name.
+ *
+ * Description: On a mismatch the matcher only ever returns to the most
+ * recent '*', retrying it one character further along the name. Since a
+ * later '*' can match whatever an earlier one could, this is enough, and
+ * the cost is bounded by the product of the lengths instead of growing
+ * exponentially with the number of stars.
+ *
+ * Return: 1 if @name matches, 0 otherwise.
+ */
+int glob_match(char *pat, char *name)
+{
+	char *star_pat = NULL, *star_name = NULL, *next;
+
+	while (*name)
+	{
+		if (*pat == '*')
+		{
+			star_pat = ++pat;
+			star_name = name;
+			continue;
+		}
+		next = match_one(pat, *name);
+		if (next)
+		{
+			pat = next;
+			name++;
+			continue;
+		}
+		if (!star_pat)
+			return (0);
+		pat = star_pat;
+		name = ++star_name;
+	}
+	while (*pat == '*')
+		pat++;
+	return (!*pat);
+}
+
+/**
+ * match_one - Matches one character against one pattern element.
+ * @pat: The pattern, at '?', a bracket expression, an escape or a literal.
+ * @c: The character.
+ *
+ * Description: A bracket expression holds characters and ranges such as
+ * a-z, negated by a leading '!' or '^'; a ']' right after the opening
+ * (or the negation) is literal, as is one escaped with '\\'. A '[' without
+ * a closing ']' is literal.
+ *
+ * Return: The pattern past the element if @c matches it, NULL otherwise.
+ */
+char *match_one(char *pat, char c)
+{
+	char *end;
+	int negate, found = 0;
+
+	if (!*pat)
+		return (NULL);
+	if (*pat == '?')
+		return (pat + 1);
+	if (*pat == '\\' && pat[1])
+		return (pat[1] == c ? pat + 2 : NULL);
+	if (*pat != '[')
+		return (*pat == c ? pat + 1 : NULL);
+	negate = pat[1] == '!' || pat[1] == '^';
+	end = pat + 1 + negate;
+	if (*end == ']')
+		end++;
+	while (*end && *end != ']')
+		end += *end == '\\' && end[1] ? 2 : 1;
+	if (!*end)
+		return ('[' == c ? pat + 1 : NULL);
+	for (pat += 1 + negate; pat < end; pat++)
+	{
+		pat += *pat == '\\' && pat + 1 < end;
+		if (pat[1] == '-' && pat + 2 < end)
+		{
+			found |= (unsigned char)c >= (unsigned char)pat[0]
+				&& (unsigned char)c <= (unsigned char)pat[2];
+			pat += 2;
+		}
+		else
+			found |= *pat == c;
+	}
+	return (found != negate ? end + 1 : NULL);
+}
+
+/**
+ * glob_list - Returns the listing of a directory, reading it if needed.
+ * @cache: The directory cache of the command being expanded.
+ * @path: The directory, "" for the working directory.
+ *
+ * Description: "." and ".." are left out, as no pattern expands to them.
+ *
+ * Return: The listing, or NULL if the directory cannot be read.
+ */
+glob_dir_t *glob_list(glob_dir_t **cache, char *path)
+{
+	glob_dir_t *dir;
+	DIR *stream;
+	struct dirent *entry;
+	size_t used = 0, size = 4096, len;
+	int max = 64;
+
+	for (dir = *cache; dir; dir = dir->next)
+		if (_strcmp(dir->path, path) == 0)
+			return (dir->names ? dir : NULL);
+	dir = malloc(sizeof(*dir));
+	if (!dir)
+		return (NULL);
+	_memset((char *)dir, 0, sizeof(*dir));
+	dir->path = _strdup(path), dir->next = *cache, *cache = dir;
+	COUNT_SYSCALL(SC_OPEN);
+	stream = opendir(*path ? path : ".");
+	dir->names = stream ? malloc(size) : NULL;
+	dir->offsets = malloc(sizeof(size_t) * max);
+	while (dir->names && dir->offsets && (entry = readdir(stream)))
+	{
+		len = _strlen(entry->d_name) + 1;
+		if (entry->d_name[0] == '.' && (len == 2 || (len == 3
+						&& entry->d_name[1] == '.')))
+			continue;
+		if (used + len > size)
+			dir->names = _realloc(dir->names, used, size = (size + len) * 2);
+		if (dir->count == max)
+			dir->offsets = _realloc(dir->offsets, sizeof(size_t) * max,
+					sizeof(size_t) * max * 2), max *= 2;
+		if (!dir->names || !dir->offsets)
+			break;
+		_strcpy(dir->names + used, entry->d_name);
+		dir->offsets[dir->count++] = used, used += len;
+	}
+	if (stream)
+		closedir(stream);
+	return (dir->names && dir->offsets ? dir : NULL);
+}
+
+/**
+ * glob_cache_free - Frees the directory cache of a command.
+ * @cache: The cache.
+ */
+void glob_cache_free(glob_dir_t *cache)
+{
+	glob_dir_t *next;
+
+	for (; cache; cache = next)
+	{
+		next = cache->next;
+		free(cache->path);
+		free(cache->names);
+		free(cache->offsets);
+		free(cache);
+	}
+}
+
+/**
+ * glob_cmp - Orders two paths bytewise, for qsort().
+ * @first: Pointer to the first path.
+ * @second: Pointer to the second path.
+ *
+ * Return: Less than, equal to or greater than 0, as with _strcmp().
+ */
+int glob_cmp(const void *first, const void *second)
+{
+	return (_strcmp(*(char **)first, *(char **)second));
+}
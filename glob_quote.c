@@ -0,0 +1,56 @@
+#include "main.h"
+
+/**
+ * copy_word - Copies one word of a command and unquotes it.
+ * @raw: The raw text of the word.
+ * @len: Its length.
+ * @flags: Where to store the QUOTE_* flags of the word.
+ *
+ * Description: A word flagged QUOTE_PATTERN is unquoted a second time,
+ * from @raw, into the larger block its pattern form needs; that form is
+ * what expand_globs() sees. Other words keep the plain copy.
+ *
+ * Return: The word, or NULL on failure.
+ */
+char *copy_word(char *raw, size_t len, char *flags)
+{
+	char *word = malloc(len + 1), *pat;
+
+	if (!word)
+		return (NULL);
+	_strncpy(word, raw, len + 1);
+	*flags = unquote_word(word, NULL);
+	if (!(*flags & QUOTE_PATTERN))
+		return (word);
+	pat = malloc(len * 2 + 1);
+	if (pat)
+	{
+		_strncpy(word, raw, len + 1);
+		unquote_word(word, pat);
+	}
+	free(word);
+	return (pat);
+}
+
+/**
+ * glob_unescape - Turns a pattern back into the text it matches literally.
+ * @pat: The pattern, compacted into itself.
+ *
+ * Description: Used on the components of a QUOTE_PATTERN word that hold
+ * no wildcard, and on the whole word when it matches nothing.
+ *
+ * Return: @pat.
+ */
+char *glob_unescape(char *pat)
+{
+	size_t in, out;
+
+	for (in = 0, out = 0; pat[in]; in++, out++)
+	{
+		if (pat[in] == '\\' && pat[in + 1])
+			in++;
+		pat[out] = pat[in];
+	}
+	pat[out] = '\0';
+	return (pat);
+}
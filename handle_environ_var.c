@@ -14,7 +14,7 @@
 int display_env_var(info_t *info_struct)
 {
 	/* Print the list of environment variables */
-	print_linked_list_str(info_struct->env);
+	print_linked_list_str(get_env_list(info_struct));
 	return (0);				   /* Return 0 to indicate success */
 }
 
@@ -32,13 +32,25 @@ int display_env_var(info_t *info_struct)
  * variable is not present. The function iterates through the environment list
  * and uses the starts_with function to check if the current environment string
  * starts with the specified name. If a match is found, the function returns
- * a pointer to the value portion of the string.
+ * a pointer to the value portion of the string. Until the list is built the
+ * process 'environ' array is searched instead.
  */
 char *get_env_var(info_t *info_struct, const char *name)
 {
 	char *p;
 	info_list *node = info_struct->env;
+	size_t i;
 
+	if (!info_struct->env_ready) /* list not built: read environ directly */
+	{
+		for (i = 0; environ[i]; i++)
+		{
+			p = starts_with(environ[i], name);
+			if (p && *p)
+				return (p);
+		}
+		return (NULL);
+	}
 	while (node)
 	{
 		/* Check if environment string starts with the name */
@@ -124,22 +136,23 @@ int clear_all_env_var(info_t *info_struct)
  *
  * Description: This function populates the environment list in the info_struct
  * structure with the contents of the 'environ' array. For each element
- * in the 'environ' array, a new node is added to the end of the list,
- * containing the environment string. The function returns 0 to indicate
- * success.
+ * in the 'environ' array, a new node is appended after the previous one
+ * (keeping the build linear), containing the environment string. The
+ * function returns 0 to indicate success.
  */
 int initialize_env_list(info_t *info_struct)
 {
 	size_t i;
-	info_list *node = NULL;
+	info_list *node = NULL, *tail = NULL;
 
-	/* Add each environment string to the list */
+	/* Add each environment string after the last node added */
 	for (i = 0; environ[i]; i++)
 	{
-		add_node_end(&node, environ[i], 0);
+		tail = add_node_end(tail ? &tail : &node, environ[i], 0);
 	}
 
 	info_struct->env = node; /* Assign the list to the info_struct structure */
+	info_struct->env_ready = 1;
 
 	return (0); /* Return 0 to indicate success */
 }
@@ -19,6 +19,7 @@ int is_exe_cmd(info_t *info_struct, char *file_path)
 	struct stat stat_struct;
 
 	(void)info_struct;
+	COUNT_SYSCALL(SC_STAT);
 	if (!file_path || stat(file_path, &stat_struct) != 0)
 	{
 		return (0);
@@ -36,6 +37,7 @@ int is_exe_cmd(info_t *info_struct, char *file_path)
 /**
  * duplicate_chars - Create a new null-terminated string from a substring.
  *
+ * @info_struct: Pointer to the information structure.
  * @str_path: The input string.
  * @start_index: The starting index (inclusive) of the substring.
  * @stop_index: The ending index (exclusive) of the substring.
@@ -43,16 +45,19 @@ int is_exe_cmd(info_t *info_struct, char *file_path)
  * This function creates a new null-terminated string by copying characters
  * from the input string starting from the specified start index and ending at
  * the stop index. Colon characters (:) in the original string are omitted in
- * the copied substring.
+ * the copied substring. It is truncated to fit the PATH_MAX bytes of the
+ * interpreter's path buffer.
  *
- * Return: A pointer to the copied substring (statically allocated).
+ * Return: A pointer to the copied substring, in info_struct->io.path_buf.
  */
-char *duplicate_chars(char *str_path, int start_index, int stop_index)
+char *duplicate_chars(info_t *info_struct, char *str_path, int start_index,
+		int stop_index)
 {
-	static char buffer[1024];
+	char *buffer = info_struct->io.path_buf;
 	int count_i = 0, count_k = 0;
 
-	for (count_i = start_index; count_i < stop_index; count_i++)
+	for (count_i = start_index; count_i < stop_index && count_k < PATH_MAX - 1;
+			count_i++)
 	{
 		if (str_path[count_i] != ':')
 		{
@@ -73,10 +78,10 @@ char *duplicate_chars(char *str_path, int start_index, int stop_index)
  * @cmd: The command name to search for.
  *
  * This function searches for the full path of a command by iterating through
- * the colon-separated directories in the search path. If the command starts
- * with "./" and is an executable in the current directory, it returns the
- * command itself. Otherwise, it looks for the command within each directory
- * in the search path.
+ * the colon-separated directories in the search path. If the command
+ * contains a '/', it is not searched for: it returns the command itself if
+ * it is executable, NULL otherwise. Otherwise, it looks for the command
+ * within each directory in the search path.
  *
  * Return: A pointer to the full path of the command if found, otherwise NULL.
  */
@@ -89,26 +94,25 @@ char *find_cmd_path(info_t *info_struct, char *str_path, char *cmd)
 	{
 		return (NULL);
 	}
-	if ((_strlen(cmd) > 2) && starts_with(cmd, "./"))
+	if (_strchr(cmd, '/')) /* a path is never looked up in PATH */
 	{
-		if (is_exe_cmd(info_struct, cmd))
-		{
-			return (cmd);
-		}
+		return (is_exe_cmd(info_struct, cmd) ? cmd : NULL);
 	}
 	while (1)
 	{
 		if (!str_path[count] || str_path[count] == ':')
 		{
-			cmd_path = duplicate_chars(str_path, current_pos, count);
-			if (!*cmd_path)
+			cmd_path = duplicate_chars(info_struct, str_path, current_pos, count);
+			if (_strlen(cmd_path) + _strlen(cmd) + 2 > PATH_MAX)
+				*cmd_path = '\0'; /* too long to be a path: never matches */
+			else if (!*cmd_path)
 				_strcat(cmd_path, cmd);
 			else
 			{
 				_strcat(cmd_path, "/");
 				_strcat(cmd_path, cmd);
 			}
-			if (is_exe_cmd(info_struct, cmd_path))
+			if (*cmd_path && is_exe_cmd(info_struct, cmd_path))
 				return (cmd_path);
 			if (!str_path[count])
 				break;
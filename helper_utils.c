@@ -6,15 +6,22 @@
  * @info_struct: Pointer to the information structure.
  *
  * This function checks whether the shell is running in an is_interactive mode
- * by determining if the standard input is a terminal and if the read file
+ * by determining if the standard input is a terminal (asked once, then
+ * cached) and if the read file
  * descriptor is less than or equal to 2 (indicating standard input, output,
- * or error).
+ * or error). A shell running a "-c" command string is never interactive.
  *
  * Return: 1 if the shell is running in is_interactive mode, 0 otherwise.
  */
 int is_interactive(info_t *info_struct)
 {
-	return (isatty(STDIN_FILENO) && info_struct->readfd <= 2);
+	if (info_struct->stdin_tty == -1)
+	{
+		COUNT_SYSCALL(SC_ISATTY);
+		info_struct->stdin_tty = isatty(STDIN_FILENO);
+	}
+	return (!info_struct->cmd_str && info_struct->stdin_tty
+			&& info_struct->readfd <= 2);
 }
 
 
@@ -110,3 +117,23 @@ int convert_str_to_int(char *input_str)
 
 	return (str_output);
 }
+
+/**
+ * shell_pid - Returns the process id of the shell.
+ *
+ * @info_struct: Pointer to the information structure.
+ *
+ * The id is fetched with getpid() on first use and cached, so repeated $$
+ * expansions do not cost a system call each.
+ *
+ * Return: The process id of the shell.
+ */
+pid_t shell_pid(info_t *info_struct)
+{
+	if (!info_struct->pid)
+	{
+		COUNT_SYSCALL(SC_GETPID);
+		info_struct->pid = getpid();
+	}
+	return (info_struct->pid);
+}
@@ -0,0 +1,25 @@
+#include "main.h"
+
+/**
+ * history_start - Finds the oldest history line worth loading.
+ * @buffer: Contents of the history file.
+ * @size: Size of @buffer.
+ *
+ * Description: A file of HIST_MAX lines or more is cut down to its last
+ * HIST_MAX - 1 lines. Scanning backwards for them avoids allocating nodes
+ * only to delete them again.
+ *
+ * Return: Offset of the first line to load, 0 to load the whole file.
+ */
+int history_start(char *buffer, ssize_t size)
+{
+	ssize_t count = size - 1;
+	int lines = 0;
+
+	if (count >= 0 && buffer[count] == '\n')
+		count--;
+	for (; count >= 0; count--)
+		if (buffer[count] == '\n' && ++lines == HIST_MAX - 1)
+			return (count + 1);
+	return (0);
+}
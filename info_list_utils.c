@@ -25,21 +25,25 @@ void clear_info_list(info_t *info_struct)
  * Description: This function initializes various fields within the info_t
  * structure using the provided array of command arguments. It sets the fname
  * field to the first argument (program name) in arg_v. It then populates the
- * argv field with the result of splitting the arg field (if not NULL) by
- * delimiters " \t". If argv allocation or splitting fails, a fallback is used
- * to allocate space for argv. The argc field is set to the count of arguments
- * in argv. The function then calls replace_cmd_with_alias and replace_cmd_argv
- * to perform
- * alias and variable replacement.
+ * argv field with the result of splitting the arg field (if not NULL) into
+ * words with split_words(), which also removes quotes and escapes. If argv
+ * allocation or splitting fails, a fallback is used to allocate space for
+ * argv. The argc field is set to the count of arguments
+ * in argv. The function then calls replace_cmd_with_alias, replace_cmd_argv
+ * and expand_globs to perform
+ * alias, variable and pathname replacement.
  */
 void set_info_list(info_t *info_struct, char **arg_v)
 {
 	int count = 0;
+	unsigned long start;
 
 	info_struct->fname = arg_v[0];
 	if (info_struct->arg)
 	{
-		info_struct->argv = strtow(info_struct->arg, " \t");
+		start = phase_start(info_struct);
+		info_struct->argv = split_words(info_struct->arg,
+				&info_struct->argq);
 		if (!info_struct->argv)
 		{
 			info_struct->argv = malloc(sizeof(char *) * 2);
@@ -52,9 +56,14 @@ void set_info_list(info_t *info_struct, char **arg_v)
 		for (count = 0; info_struct->argv && info_struct->argv[count]; count++)
 			;
 		info_struct->argc = count;
+		phase_end(info_struct, PH_TOKENIZE, start);
 
+		start = phase_start(info_struct);
 		replace_cmd_with_alias(info_struct);
 		replace_cmd_argv(info_struct);
+		expand_globs(info_struct);
+		info_struct->argq = NULL;
+		phase_end(info_struct, PH_EXPAND, start);
 	}
 }
 
@@ -92,11 +101,15 @@ void free_info_list(info_t *info_struct, int free_all)
 		{
 			free_list(&(info_struct->alias));
 		}
+		free_functions(info_struct);
+		comp_free(info_struct);
+		free_ptr((void **)&info_struct->latency);
 		free_ptr_array(info_struct->environ);
 		info_struct->environ = NULL;
 		free_ptr((void **)info_struct->cmd_buf);
 		if (info_struct->readfd > 2)
 		{
+			COUNT_SYSCALL(SC_CLOSE);
 			close(info_struct->readfd);
 		}
 		_putchar(BUF_FLUSH);
@@ -8,7 +8,8 @@
  *
  * Description: This function reads input from user, fills the input buffer,
  * and handles various scenarios such as removing trailing newlines, removing
- * comments, and adding the input to the history list. If no input is left in
+ * comments, and adding the input to the history list (interactive sessions
+ * only). If no input is left in
  * the buffer, it will read a new line from the user and perform the necessary
  * operations on it.
  *
@@ -24,11 +25,10 @@ ssize_t input_buffer(info_t *info_struct, char **buffer, size_t *len)
 	{
 		free(*buffer);
 		*buffer = NULL;
-		signal(SIGINT, sigint_handler);
 #if USE_GETLINE
 		r = getline(buffer, &len_p, stdin);
 #else
-		r = get_stdin_line(info_struct, buffer, &len_p);
+		r = read_input_line(info_struct, buffer, &len_p);
 #endif
 		if (r > 0)
 		{
@@ -39,7 +39,10 @@ ssize_t input_buffer(info_t *info_struct, char **buffer, size_t *len)
 			}
 			info_struct->linecount_flag = 1;
 			remove_comments(*buffer);
-			add_to_history_list(info_struct, *buffer, info_struct->histcount++);
+			if (is_interactive(info_struct))
+				add_to_history_list(info_struct, *buffer,
+						info_struct->histcount++);
+			r = define_functions(info_struct, buffer, r);
 			/* if (_strchr(*buf, ';')) is this a command chain? */
 			{
 				*len = r;
@@ -50,55 +53,92 @@ ssize_t input_buffer(info_t *info_struct, char **buffer, size_t *len)
 	return (r);
 }
 
+/**
+ * define_functions - Defines the functions a line starts with.
+ * @info_struct: Pointer to the info_t structure.
+ * @buffer: Pointer to the line, replaced by what follows the definitions.
+ * @len: Length of the line.
+ *
+ * Description: A line may define several functions and then run commands,
+ * as in "f() { echo f; }; f". Each definition is taken off the front of the
+ * line in turn; a definition that fails to parse drops the whole line.
+ *
+ * Return: The length of what is left of the line.
+ */
+ssize_t define_functions(info_t *info_struct, char **buffer, ssize_t len)
+{
+	char *func_name, *func_rest, *rest;
+
+	while ((func_rest = parse_func_header(*buffer, &func_name)))
+	{
+		rest = define_function(info_struct, func_name, func_rest);
+		if (!rest)
+		{
+			**buffer = '\0';
+			return (0);
+		}
+		free(*buffer);
+		*buffer = rest;
+		len = _strlen(rest);
+	}
+	return (len);
+}
+
 /**
  * get_input - Get input from the user and handle command chaining.
  * @info_struct: Pointer to the info_t structure.
  *
  * Description: This function reads input from the user and handles command
  * chaining by detecting and processing semicolons. It also maintains a buffer
- * for command chaining and iterates through the buffer to find individual
- * commands separated by semicolons.
+ * for command chaining, kept in info_struct->io, and iterates through the
+ * buffer to find individual commands separated by semicolons. Separators
+ * that are quoted or escaped are skipped.
  *
  * Return: On success, returns the number of characters read. On failure,
  * returns -1.
  */
 ssize_t get_input(info_t *info_struct)
 {
-	static char *buffer; /* the ';' command chain buffer */
-	static size_t count_i, count_j, len;
+	shell_io_t *io = &(info_struct->io); /* holds the ';' chain buffer */
 	ssize_t buffer_len = 0;
 	char **buffer_ptr = &(info_struct->arg), *ptr;
 
 	_putchar(BUF_FLUSH);
-	buffer_len = input_buffer(info_struct, &buffer, &len);
+	buffer_len = input_buffer(info_struct, &io->chain_buf, &io->chain_len);
 	if (buffer_len == -1) /* EOF */
 		return (-1);
-	if (len) /* we have commands left in the chain buffer */
+	if (io->chain_len) /* we have commands left in the chain buffer */
 	{
-		count_j = count_i;		 /* init iterator to current buf position */
-		ptr = buffer + count_i; /* get pointer for return */
+		io->chain_end = io->chain_pos; /* init iterator to current position */
+		ptr = io->chain_buf + io->chain_pos; /* get pointer for return */
 
-		check_cmd_chain(info_struct, buffer, &count_j, count_i, len);
-		while (count_j < len) /* iterate to semicolon or end */
+		check_cmd_chain(info_struct, io->chain_buf, &io->chain_end,
+				io->chain_pos, io->chain_len);
+		while (io->chain_end < io->chain_len) /* iterate to ';' or end */
 		{
-			if (is_chain_delimiter(info_struct, buffer, &count_j))
+			if (quote_end(io->chain_buf, io->chain_end) != io->chain_end)
+				io->chain_end = quote_end(io->chain_buf, io->chain_end);
+			else if (is_chain_delimiter(info_struct, io->chain_buf,
+						&io->chain_end))
 			{
 				break;
 			}
-			count_j++;
+			io->chain_end++;
 		}
 
-		count_i = count_j + 1;	  /* increment past nulled ';'' */
-		if (count_i >= len) /* reached end of buffer? */
+		io->chain_pos = io->chain_end + 1; /* increment past nulled ';'' */
+		if (io->chain_pos >= io->chain_len) /* reached end of buffer? */
 		{
-			count_i = len = 0; /* reset position and length */
+			io->chain_pos = io->chain_len = 0; /* reset position and length */
 			info_struct->cmd_buf_type = CMD_NORM;
 		}
 
+		info_struct->cmd_pending = io->chain_len != 0;
 		*buffer_ptr = ptr;		/* pass pointer to current command position */
 		return (_strlen(ptr)); /* return length of current command */
 	}
-*buffer_ptr = buffer; /* else not chain,pass back buffer frm get_stdin_line()*/
+	info_struct->cmd_pending = 0;
+	*buffer_ptr = io->chain_buf; /* not a chain, pass back the whole line */
 	return (buffer_len);	  /* return length of buffer from get_stdin_line() */
 }
 
@@ -123,6 +163,7 @@ ssize_t read_buffer(info_t *info_struct, char *buffer, size_t *size)
 	{
 		return (0);
 	}
+	COUNT_SYSCALL(SC_READ);
 	read_r = read(info_struct->readfd, buffer, READ_BUF_SIZE);
 
 	if (read_r >= 0)
@@ -140,65 +181,55 @@ ssize_t read_buffer(info_t *info_struct, char *buffer, size_t *size)
  * @length: Pointer to the length of the buffer.
  *
  * Description: This function reads a line from standard input into a buffer,
- * expanding the buffer as needed. It maintains state to track the current
- * position within the buffer for efficient reading across multiple calls.
+ * expanding the buffer as needed. The read buffer and the current position
+ * within it are kept in info_struct->io across calls.
+ * A line that straddles the end of the read buffer is completed with
+ * further reads, so callers always get whole lines. The line buffer grows
+ * by doubling, keeping a line of n bytes O(n) to read.
  *
  * Return: On success, returns the length of the line (including newline
  * character). Returns -1 on failure or end-of-file.
  */
 int get_stdin_line(info_t *info_struct, char **ptr_address, size_t *length)
 {
-	size_t count_k;
+	size_t count_k, cap;
 	ssize_t read = 0, s_len = 0;
-	char *ptr = NULL, *ptr_new = NULL, *c_ptr;
-	static char buffer[READ_BUF_SIZE];
-	static size_t count_i, len;
+	char *ptr = NULL, *ptr_new = NULL, *buffer = info_struct->io.read_buf;
+	size_t *count_i = &(info_struct->io.read_pos);
+	size_t *len = &(info_struct->io.read_len);
 
 	ptr = *ptr_address;
 	if (ptr && length)
 		s_len = *length;
-	if (count_i == len)
-		count_i = len = 0;
-
-	read = read_buffer(info_struct, buffer, &len);
-	if (read == -1 || (read == 0 && len == 0))
+	cap = s_len;
+	do {
+		if (*count_i == *len)
+			*count_i = *len = 0;
+		read = read_buffer(info_struct, buffer, len);
+		if (read == -1 || (read == 0 && *len == 0))
+			break;
+
+		for (count_k = *count_i; count_k < *len && buffer[count_k] != '\n';)
+			count_k++;
+		count_k += count_k < *len; /* keep the newline */
+		if (s_len + (count_k - *count_i) + 1 > cap) /* grow by doubling */
+		{
+			cap = (s_len + (count_k - *count_i) + 1) * 2;
+			ptr_new = _realloc(ptr, s_len, cap);
+			if (!ptr_new) /* MALLOC FAILURE! */
+				return (ptr ? free(ptr), -1 : -1);
+			ptr = ptr_new;
+		}
+		_strncpy(ptr + s_len, buffer + *count_i, count_k - *count_i + 1);
+		s_len += count_k - *count_i;
+		*count_i = count_k;
+	} while (ptr[s_len - 1] != '\n'); /* line continues in the next read */
+	info_struct->read_pending = *len - *count_i;
+	if (!s_len)
 		return (-1);
 
-	c_ptr = _strchr(buffer + count_i, '\n');
-	count_k = c_ptr ? 1 + (unsigned int)(c_ptr - buffer) : len;
-	ptr_new = _realloc(ptr, s_len, s_len ? s_len + count_k : count_k + 1);
-	if (!ptr_new) /* MALLOC FAILURE! */
-		return (ptr ? free(ptr), -1 : -1);
-
-	if (s_len)
-		_strncat(ptr_new, buffer + count_i, count_k - count_i);
-	else
-		_strncpy(ptr_new, buffer + count_i, count_k - count_i + 1);
-
-	s_len += count_k - count_i;
-	count_i = count_k;
-	ptr = ptr_new;
-
 	if (length)
 		*length = s_len;
 	*ptr_address = ptr;
 	return (s_len);
 }
-
-/**
- * sigint_handler - Signal handler for SIGINT (Ctrl+C).
- * @signal_num: The signal number (unused).
- *
- * Description:
- * This function is called when the user presses Ctrl+C.
- * It prints a newline and the shell prompt to start a new line.
- *
- * Return: None.
- */
-void sigint_handler(__attribute__((unused)) int signal_num)
-{
-	_puts("\n");
-	_puts("$ ");
-	_putchar(BUF_FLUSH);
-}
-
@@ -0,0 +1,152 @@
+#include "main.h"
+
+/**
+ * quote_end - Finds the last character of a quoted span.
+ * @str: The command text.
+ * @pos: Index of the character to look at.
+ *
+ * Description: A backslash covers the character after it, a quote runs to
+ * its closing quote. Inside double quotes a backslash still protects the
+ * next character. An unclosed quote runs to the end of @str.
+ *
+ * Return: Index of the last character of the span starting at @pos, or
+ * @pos itself if no span starts there.
+ */
+size_t quote_end(char *str, size_t pos)
+{
+	char quote = str[pos];
+
+	if (quote == '\\')
+		return (str[pos + 1] ? pos + 1 : pos);
+	if (quote != '\'' && quote != '"')
+		return (pos);
+	for (pos++; str[pos] && str[pos] != quote; pos++)
+		if (quote == '"' && str[pos] == '\\' && str[pos + 1])
+			pos++;
+	return (str[pos] ? pos : pos - 1);
+}
+
+/**
+ * word_end - Measures the raw text of a word.
+ * @str: Start of the word.
+ *
+ * Return: The number of characters up to the first blank that is neither
+ * quoted nor escaped.
+ */
+size_t word_end(char *str)
+{
+	size_t pos;
+
+	for (pos = 0; str[pos] && !is_delimiter(str[pos], " \t"); pos++)
+		pos = quote_end(str, pos);
+	return (pos);
+}
+
+/**
+ * quote_flag - Tells what quoting a character switches off.
+ * @c: A character that was quoted or escaped.
+ *
+ * Return: QUOTE_NOVAR for '$', QUOTE_NOGLOB for a character that is
+ * special in a pattern, 0 otherwise.
+ */
+int quote_flag(char c)
+{
+	if (c == '$')
+		return (QUOTE_NOVAR);
+	if (c && _strchr("*?[]\\", c))
+		return (QUOTE_NOGLOB);
+	return (0);
+}
+
+/**
+ * unquote_word - Removes the quotes and escapes of a word.
+ * @word: The raw word, compacted into itself unless @pat is given.
+ * @pat: NULL, or room for twice the length of @word, where the word is
+ * written as a pattern instead: its quoted '*', '?', '[', ']' and '\'
+ * get a '\' in front, so that only the unquoted wildcards stay special.
+ *
+ * Description: Single quotes keep everything literally. Double quotes keep
+ * everything but '$', and a backslash in them only escapes '$', '`', '"'
+ * and '\'. Outside quotes a backslash escapes any character.
+ *
+ * Return: The QUOTE_* flags of the expansions the quoting disables. A word
+ * that holds an unquoted wildcard besides quoted special characters gets
+ * QUOTE_PATTERN instead of QUOTE_NOGLOB: it must be globbed as a pattern.
+ */
+int unquote_word(char *word, char *pat)
+{
+	size_t in, out = 0;
+	int flags = 0, quoted, wild = 0;
+	char quote = 0, *dest = pat ? pat : word;
+
+	for (in = 0; word[in]; in++)
+	{
+		if (quote ? word[in] == quote : word[in] == '\'' || word[in] == '"')
+		{
+			quote = quote ? 0 : word[in];
+			continue;
+		}
+		quoted = quote == '\'' || (quote && word[in] != '$');
+		if (word[in] == '\\' && word[in + 1] && quote != '\''
+				&& (!quote || _strchr("$`\"\\", word[in + 1])))
+			quoted = 1, in++;
+		if (quoted)
+			flags |= quote_flag(word[in]);
+		else
+			wild |= word[in] == '*' || word[in] == '?' || word[in] == '[';
+		if (pat && quoted && quote_flag(word[in]) == QUOTE_NOGLOB)
+			dest[out++] = '\\';
+		dest[out++] = word[in];
+	}
+	dest[out] = '\0';
+	if (wild && flags & QUOTE_NOGLOB)
+		flags ^= QUOTE_NOGLOB | QUOTE_PATTERN;
+	return (flags);
+}
+
+/**
+ * split_words - Splits a command into unquoted words.
+ * @str: The command text.
+ * @quotes: Where to store the QUOTE_* flags of every word.
+ *
+ * Description: Each word is copied once, as strtow() did, and unquoted
+ * inside that copy by copy_word(). The flags live in the same block as
+ * the pointer array, after its NULL, so they are released by
+ * free_ptr_array() and quoting costs no allocation of its own.
+ *
+ * Return: The NULL-terminated words, or NULL if there are none or on
+ * failure.
+ */
+char **split_words(char *str, char **quotes)
+{
+	size_t pos, len;
+	int count, num_words = 0;
+	char **words;
+
+	*quotes = NULL;
+	for (pos = 0; str && str[pos]; pos += len)
+	{
+		while (is_delimiter(str[pos], " \t"))
+			pos++;
+		len = word_end(str + pos);
+		num_words += len > 0;
+	}
+	if (!num_words)
+		return (NULL);
+	words = malloc((num_words + 1) * sizeof(char *) + num_words);
+	if (!words)
+		return (NULL);
+	for (pos = 0, count = 0; count < num_words; count++, pos += len)
+	{
+		while (is_delimiter(str[pos], " \t"))
+			pos++;
+		len = word_end(str + pos);
+		words[count] = copy_word(str + pos, len,
+				(char *)(words + num_words + 1) + count);
+		if (!words[count])
+			return (free_ptr_array(words), NULL);
+	}
+	words[count] = NULL;
+	*quotes = (char *)(words + num_words + 1);
+	return (words);
+}
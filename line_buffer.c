@@ -0,0 +1,100 @@
+#include "main.h"
+
+/**
+ * edit_insert - Inserts text at the cursor of the line being edited.
+ * @ed: The line being edited.
+ * @text: The text.
+ * @len: Its length.
+ *
+ * Description: The cursor ends up after the text. Nothing is drawn here;
+ * edit_redraw() shows the change.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int edit_insert(line_edit_t *ed, char *text, size_t len)
+{
+	char *buf;
+	size_t index;
+
+	if (ed->len + len + 1 > ed->max)
+	{
+		buf = _realloc(ed->buf, ed->max, ed->max * 2 + len + 64);
+		if (!buf)
+			return (-1);
+		ed->buf = buf;
+		ed->max = ed->max * 2 + len + 64;
+		ed->buf[ed->len] = '\0';
+	}
+	for (index = ed->len + 1; index-- > ed->pos;)
+		ed->buf[index + len] = ed->buf[index];
+	for (index = 0; index < len; index++)
+		ed->buf[ed->pos++] = text[index];
+	ed->len += len;
+	return (0);
+}
+
+/**
+ * edit_delete - Deletes part of the line being edited.
+ * @ed: The line being edited.
+ * @from: Offset of the first byte to delete.
+ * @to: Offset just past the last byte to delete.
+ *
+ * Description: The cursor is left where the deleted text was.
+ */
+void edit_delete(line_edit_t *ed, size_t from, size_t to)
+{
+	size_t index;
+
+	for (index = to; index <= ed->len; index++)
+		ed->buf[from + index - to] = ed->buf[index];
+	ed->len -= to - from;
+	ed->pos = from;
+}
+
+/**
+ * edit_set - Replaces the whole line being edited.
+ * @ed: The line being edited.
+ * @text: The new line.
+ *
+ * Description: The cursor is put at the end of the line.
+ */
+void edit_set(line_edit_t *ed, char *text)
+{
+	ed->len = ed->pos = 0;
+	ed->buf[0] = '\0';
+	edit_insert(ed, text, _strlen(text));
+}
+
+/**
+ * utf8_back - Finds the UTF-8 character before an offset.
+ * @buf: The text.
+ * @pos: An offset in @buf, not 0.
+ *
+ * Return: The offset of the first byte of the character before @pos.
+ */
+size_t utf8_back(char *buf, size_t pos)
+{
+	do {
+		pos--;
+	} while (pos && (buf[pos] & 0xC0) == 0x80);
+	return (pos);
+}
+
+/**
+ * utf8_cols - Counts the terminal columns of UTF-8 text.
+ * @text: The text.
+ * @len: Number of bytes of @text to count.
+ *
+ * Description: Every character is taken as one column wide; combining
+ * and double-width characters are not told apart.
+ *
+ * Return: The number of characters in the first @len bytes of @text.
+ */
+size_t utf8_cols(char *text, size_t len)
+{
+	size_t index, cols = 0;
+
+	for (index = 0; index < len; index++)
+		cols += (text[index] & 0xC0) != 0x80;
+	return (cols);
+}
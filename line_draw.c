@@ -0,0 +1,119 @@
+#include "main.h"
+
+/**
+ * edit_out - Queues terminal output of the line editor.
+ * @ed: The line being edited.
+ * @text: The output, or NULL to write out what is queued.
+ * @len: Length of @text.
+ */
+void edit_out(line_edit_t *ed, char *text, size_t len)
+{
+	size_t index;
+
+	for (index = 0; text && index < len; index++)
+	{
+		if (ed->out_len == sizeof(ed->out))
+			edit_out(ed, NULL, 0);
+		ed->out[ed->out_len++] = text[index];
+	}
+	if (!text && ed->out_len)
+	{
+		COUNT_SYSCALL(SC_WRITE);
+		write(STDOUT_FILENO, ed->out, ed->out_len);
+		ed->out_len = 0;
+	}
+}
+
+/**
+ * edit_redraw - Brings the terminal up to date with the edited line.
+ * @ed: The line being edited.
+ *
+ * Description: The new text of the terminal line is compared with what
+ * it shows. Only the cells from the first difference on are rewritten,
+ * the rest of the old text is cleared if the line got shorter, and the
+ * cursor is moved to its place. Typing at the end of the line costs one
+ * character of output; moving the cursor costs one escape sequence.
+ */
+void edit_redraw(line_edit_t *ed)
+{
+	char *shown = ed->shown ? ed->shown : "", *view;
+	size_t same = 0, len, prompt;
+
+	view = edit_view(ed, &prompt);
+	if (!view)
+		return;
+	len = _strlen(view);
+	while (shown[same] && shown[same] == view[same])
+		same++;
+	while (same && (view[same] & 0xC0) == 0x80)
+		same--;
+	if (same < len || shown[same])
+	{
+		edit_move(ed, utf8_cols(view, same));
+		edit_out(ed, view + same, len - same);
+		ed->col = utf8_cols(view, len);
+		if (utf8_cols(shown, _strlen(shown)) > ed->col)
+			edit_out(ed, "\033[K", 3);
+	}
+	edit_move(ed, utf8_cols(view, prompt + ed->pos));
+	free(ed->shown);
+	ed->shown = view;
+}
+
+/**
+ * edit_view - Builds the text the terminal line should show.
+ * @ed: The line being edited.
+ * @prompt: Where to store the length of the part before the line.
+ *
+ * Return: The prompt followed by the line, or NULL on failure.
+ */
+char *edit_view(line_edit_t *ed, size_t *prompt)
+{
+	char *head = "$ ", *view;
+
+	if (ed->searching)
+		head = ed->failed ? "(failed reverse-i-search)`"
+			: "(reverse-i-search)`";
+	*prompt = _strlen(head) + (ed->searching ? ed->query_len + 3 : 0);
+	view = malloc(*prompt + ed->len + 1);
+	if (!view)
+		return (NULL);
+	_strcpy(view, head);
+	if (ed->searching)
+		_strcat(_strcat(view, ed->query), "': ");
+	return (_strcat(view, ed->buf));
+}
+
+/**
+ * edit_move - Moves the terminal cursor within the line.
+ * @ed: The line being edited.
+ * @col: The column to move to.
+ */
+void edit_move(line_edit_t *ed, size_t col)
+{
+	char *count;
+
+	if (col == ed->col)
+		return;
+	count = num_str_converter(col > ed->col ? col - ed->col
+			: ed->col - col, 10, 0);
+	edit_out(ed, "\033[", 2);
+	edit_out(ed, count, _strlen(count));
+	edit_out(ed, col > ed->col ? "C" : "D", 1);
+	ed->col = col;
+}
+
+/**
+ * utf8_next - Finds the UTF-8 character after an offset.
+ * @buf: The text, '\0'-terminated.
+ * @pos: The offset of a character of @buf.
+ *
+ * Return: The offset of the character after the one at @pos.
+ */
+size_t utf8_next(char *buf, size_t pos)
+{
+	do {
+		pos++;
+	} while (buf[pos] && (buf[pos] & 0xC0) == 0x80);
+	return (pos);
+}
@@ -0,0 +1,215 @@
+#include "main.h"
+
+/**
+ * edit_line - Reads a line from the terminal through the line editor.
+ * @info_struct: Pointer to the info_t structure.
+ * @ptr_address: Pointer to the address of the line buffer.
+ * @length: Pointer to the length of the line buffer.
+ *
+ * Description: This replaces get_stdin_line() for interactive input. The
+ * terminal is only in raw mode while a line is edited, so commands run
+ * with the settings they were started with. The screen is brought up to
+ * date once per read(), with a single write(). A Ctrl-C pressed while a
+ * command ran is forgotten, not applied to the new line.
+ *
+ * Return: The length of the line, newline included, or -1 on end of
+ * input or failure.
+ */
+int edit_line(info_t *info_struct, char **ptr_address, size_t *length)
+{
+	shell_io_t *io = &(info_struct->io);
+	line_edit_t ed;
+	struct termios saved;
+
+	if (tty_raw(&saved, 1) == -1)
+		return (get_stdin_line(info_struct, ptr_address, length));
+	_memset((char *)&ed, 0, sizeof(ed));
+	ed.shown = _strdup("$ "), ed.col = 2; /* printed by run_commands() */
+	sigint_taken();
+	ed.done = edit_insert(&ed, "", 0);
+	while (!ed.done)
+	{
+		edit_read(info_struct, &ed);
+		if (ed.done == 1)
+			ed.pos = ed.len;
+		edit_redraw(&ed);
+		if (ed.done == 1)
+			edit_out(&ed, "\n", 1);
+		edit_out(&ed, NULL, 0);
+	}
+	tty_raw(&saved, 0);
+	info_struct->read_pending = io->read_len - io->read_pos;
+	free(ed.shown);
+	free(ed.saved);
+	if (ed.done == -1 || edit_insert(&ed, "\n", 1) == -1)
+		return (free(ed.buf), -1);
+	free(*ptr_address);
+	*ptr_address = ed.buf;
+	if (length)
+		*length = ed.len;
+	return (ed.len);
+}
+
+/**
+ * tty_raw - Switches the terminal into raw mode or back.
+ * @saved: The settings to save to, or to restore from.
+ * @on: 1 to switch to raw mode, 0 to restore @saved.
+ *
+ * Description: Raw here means without line buffering and echo. Output
+ * processing stays on, and so does ISIG, so Ctrl-C still raises SIGINT.
+ *
+ * Return: 0 on success, -1 if standard input is not a terminal.
+ */
+int tty_raw(struct termios *saved, int on)
+{
+	struct termios raw;
+
+	COUNT_SYSCALL(SC_TTY);
+	if (!on)
+		return (tcsetattr(STDIN_FILENO, TCSADRAIN, saved));
+	if (tcgetattr(STDIN_FILENO, saved) == -1)
+		return (-1);
+	raw = *saved;
+	raw.c_lflag &= ~(ICANON | ECHO | IEXTEN);
+	raw.c_iflag &= ~(IXON | ICRNL);
+	raw.c_cc[VMIN] = 1;
+	raw.c_cc[VTIME] = 0;
+	COUNT_SYSCALL(SC_TTY);
+	return (tcsetattr(STDIN_FILENO, TCSADRAIN, &raw));
+}
+
+/**
+ * edit_read - Waits for keys or SIGINT and handles them.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ *
+ * Description: The terminal and the SIGINT self-pipe are polled together,
+ * so Ctrl-C is seen as soon as it is pressed; it drops the line and
+ * starts a new one. Keys are read into the same read buffer
+ * get_stdin_line() uses, so text pasted past the end of a line is kept
+ * for the next one.
+ */
+void edit_read(info_t *info_struct, line_edit_t *ed)
+{
+	shell_io_t *io = &(info_struct->io);
+	struct pollfd fds[2];
+
+	if (io->read_pos == io->read_len)
+	{
+		io->read_pos = io->read_len = 0;
+		fds[0].fd = STDIN_FILENO, fds[0].events = POLLIN;
+		fds[1].fd = sigint_pipe()[0], fds[1].events = POLLIN;
+		COUNT_SYSCALL(SC_EVENT);
+		if (poll(fds, 2, -1) == -1)
+		{
+			ed->done = errno == EINTR ? 0 : -1;
+			return;
+		}
+		if (fds[1].revents & POLLIN && sigint_taken())
+		{
+			ed->pos = ed->len, ed->searching = 0, edit_redraw(ed);
+			edit_out(ed, "^C\n", 3);
+			free(ed->shown), ed->shown = NULL, ed->col = 0;
+			edit_set(ed, ""), ed->hist = 0;
+			info_struct->status = 130;
+			return;
+		}
+		if (!fds[0].revents)
+			return;
+		if (read_buffer(info_struct, io->read_buf, &io->read_len) <= 0)
+			ed->done = -1;
+	}
+	while (!ed->done && io->read_pos < io->read_len)
+		io->read_pos += edit_key(info_struct, ed, io->read_buf
+				+ io->read_pos, io->read_len - io->read_pos);
+}
+
+/**
+ * edit_key - Handles one key of the line editor.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ * @keys: The unhandled input, starting with the key.
+ * @count: Number of bytes in @keys.
+ *
+ * Description: Enter ends the line and Ctrl-D on an empty line ends the
+ * input. Tab completes and Ctrl-R searches the history. The other keys
+ * follow Emacs: Ctrl-A/E/B/F move, Ctrl-P/N browse the history, Ctrl-U/K
+ * delete before or after the cursor. Backspace and Ctrl-D delete whole
+ * UTF-8 characters.
+ *
+ * Return: The number of bytes of @keys the key takes.
+ */
+size_t edit_key(info_t *info_struct, line_edit_t *ed, char *keys,
+		size_t count)
+{
+	unsigned char key = keys[0];
+
+	if ((ed->searching || key == 18) && edit_search(info_struct, ed, key))
+		return (1);
+	if (key == 27)
+		return (edit_escape(info_struct, ed, keys, count));
+	if (key == '\r' || key == '\n')
+		ed->done = 1;
+	else if (key == 4 && !ed->len) /* Ctrl-D */
+		ed->done = -1;
+	else if (key == 4 && ed->pos < ed->len)
+		edit_delete(ed, ed->pos, utf8_next(ed->buf, ed->pos));
+	else if (key == '\t')
+		complete_line(info_struct, ed);
+	else if ((key == 127 || key == '\b') && ed->pos)
+		edit_delete(ed, utf8_back(ed->buf, ed->pos), ed->pos);
+	else if (key == 1 || key == 5)
+		ed->pos = key == 1 ? 0 : ed->len;
+	else if (key == 2 && ed->pos)
+		ed->pos = utf8_back(ed->buf, ed->pos);
+	else if (key == 6 && ed->pos < ed->len)
+		ed->pos = utf8_next(ed->buf, ed->pos);
+	else if (key == 21) /* Ctrl-U */
+		edit_delete(ed, 0, ed->pos);
+	else if (key == 11) /* Ctrl-K */
+		edit_delete(ed, ed->pos, ed->len);
+	else if ((key == 16 || key == 14) && edit_history(info_struct, ed,
+				ed->hist + (key == 16 ? 1 : -1)) == -1)
+		edit_out(ed, "\a", 1);
+	else if (key >= ' ' && key != 127)
+		edit_insert(ed, keys, 1);
+	return (1);
+}
+
+/**
+ * edit_escape - Handles an escape sequence sent by a cursor key.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ * @keys: The unhandled input, starting with the escape.
+ * @count: Number of bytes in @keys.
+ *
+ * Description: The arrow, Home and End keys are handled as the control
+ * keys that do the same; Delete deletes the character under the cursor.
+ * Other sequences are skipped whole.
+ *
+ * Return: The number of bytes of @keys the sequence takes.
+ */
+size_t edit_escape(info_t *info_struct, line_edit_t *ed, char *keys,
+		size_t count)
+{
+	char finals[] = "ABCDHF", ctrls[] = {16, 14, 6, 2, 1, 5}, final;
+	size_t used = 2, index;
+
+	if (count < 3 || (keys[1] != '[' && keys[1] != 'O'))
+		return (1);
+	while (keys[1] == '[' && used < count
+			&& (keys[used] < '@' || keys[used] > '~'))
+		used++;
+	if (used == count)
+		return (count);
+	final = keys[used];
+	if (final == '~') /* ESC [ n ~ */
+		final = keys[2] == '3' ? 'X' : keys[2] == '1' || keys[2] == '7'
+			? 'H' : keys[2] == '4' || keys[2] == '8' ? 'F' : 0;
+	if (final == 'X' && ed->pos < ed->len)
+		edit_delete(ed, ed->pos, utf8_next(ed->buf, ed->pos));
+	for (index = 0; final && finals[index]; index++)
+		if (finals[index] == final)
+			edit_key(info_struct, ed, ctrls + index, 1);
+	return (used + 1);
+}
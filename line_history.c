@@ -0,0 +1,139 @@
+#include "main.h"
+
+/**
+ * hist_entry - Returns a history entry counted from the newest.
+ * @info_struct: Pointer to the info_t structure.
+ * @back: 1 for the newest entry, 2 for the one before, and so on.
+ *
+ * Return: The entry, or NULL if there are fewer than @back entries.
+ */
+char *hist_entry(info_t *info_struct, int back)
+{
+	info_list *node;
+	int count = 0;
+
+	for (node = info_struct->history; node; node = node->next)
+		count++;
+	if (back < 1 || back > count)
+		return (NULL);
+	for (node = info_struct->history; count > back; count--)
+		node = node->next;
+	return (node->str);
+}
+
+/**
+ * edit_history - Puts a history entry on the line.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ * @back: The entry as counted by hist_entry(), or 0 for the new line.
+ *
+ * Description: The new line is saved when the history is first entered
+ * and put back when it is left.
+ *
+ * Return: 0 on success, -1 if there is no such entry.
+ */
+int edit_history(info_t *info_struct, line_edit_t *ed, int back)
+{
+	char *entry = back ? hist_entry(info_struct, back) : ed->saved;
+
+	if (back < 0 || (back && !entry))
+		return (-1);
+	if (!ed->hist && back)
+	{
+		free(ed->saved);
+		ed->saved = _strdup(ed->buf);
+	}
+	ed->hist = back;
+	edit_set(ed, entry ? entry : "");
+	return (0);
+}
+
+/**
+ * search_find - Finds the next history entry holding the search query.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ * @back: The entry to start from, as counted by hist_entry().
+ *
+ * Description: The newest entry from @back towards the oldest wins. The
+ * list runs from the oldest entry, so one pass over it finds it. The
+ * match is put on the line with the cursor on the query.
+ *
+ * Return: 0 if an entry matched, -1 otherwise.
+ */
+int search_find(info_t *info_struct, line_edit_t *ed, int back)
+{
+	info_list *node;
+	int count = 0, index = 0, found = 0;
+	size_t offset = 0;
+	char *at;
+
+	ed->failed = 0;
+	if (!ed->query_len)
+		return (0);
+	for (node = info_struct->history; node; node = node->next)
+		count++;
+	for (node = info_struct->history; node && index <= count - back;
+			node = node->next, index++)
+		for (at = node->str; *at; at++)
+			if (starts_with(at, ed->query))
+			{
+				found = count - index, offset = at - node->str;
+				break;
+			}
+	if (!found)
+	{
+		ed->failed = 1;
+		edit_out(ed, "\a", 1);
+		return (-1);
+	}
+	edit_history(info_struct, ed, found);
+	ed->pos = offset;
+	return (0);
+}
+
+/**
+ * edit_search - Handles a key of a Ctrl-R history search.
+ * @info_struct: Pointer to the info_t structure.
+ * @ed: The line being edited.
+ * @key: The key.
+ *
+ * Description: Ctrl-R starts the search and then looks further back.
+ * Typed text extends the query, Backspace shortens it, and Ctrl-G gives
+ * up and puts back the line the search started from. Any other key
+ * keeps the match and is then handled as usual.
+ *
+ * Return: 1 if the key was handled, 0 if it ended the search.
+ */
+int edit_search(info_t *info_struct, line_edit_t *ed, unsigned char key)
+{
+	if (!ed->searching)
+	{
+		ed->searching = 1, ed->failed = 0, ed->search_from = ed->hist;
+		ed->query_len = 0, ed->query[0] = '\0';
+		if (!ed->hist)
+			free(ed->saved), ed->saved = _strdup(ed->buf);
+	}
+	else if (key == 18) /* Ctrl-R */
+		search_find(info_struct, ed, ed->hist + 1);
+	else if (key == 7) /* Ctrl-G */
+	{
+		ed->searching = 0;
+		edit_history(info_struct, ed, ed->search_from);
+	}
+	else if (key == 127 || key == '\b')
+	{
+		if (ed->query_len)
+			ed->query_len = utf8_back(ed->query, ed->query_len);
+		ed->query[ed->query_len] = '\0';
+		search_find(info_struct, ed, 1);
+	}
+	else if (key >= ' ')
+	{
+		if (ed->query_len + 1 < sizeof(ed->query))
+			ed->query[ed->query_len++] = key, ed->query[ed->query_len] = '\0';
+		search_find(info_struct, ed, ed->hist ? ed->hist : 1);
+	}
+	else
+		return (ed->searching = 0);
+	return (1);
+}
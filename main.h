@@ -11,6 +11,17 @@
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <stdio.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/syscall.h>
+#include <dirent.h>
+#include <termios.h>
+#include <poll.h>
 
 
 #define READ_BUF_SIZE 1024
@@ -22,6 +33,10 @@
 #define CMD_AND		2
 #define CMD_CHAIN	3
 
+#define QUOTE_NOVAR	1
+#define QUOTE_NOGLOB	2
+#define QUOTE_PATTERN	4
+
 #define CONVERT_LOWERCASE	1
 #define CONVERT_UNSIGNED	2
 
@@ -31,6 +46,109 @@
 #define HIST_FILE	".hsh_shell_history"
 #define HIST_MAX	4096
 
+#define SC_READ		0
+#define SC_WRITE	1
+#define SC_OPEN		2
+#define SC_CLOSE	3
+#define SC_STAT		4
+#define SC_FSTAT	5
+#define SC_LSEEK	6
+#define SC_ISATTY	7
+#define SC_FORK		8
+#define SC_EXECVE	9
+#define SC_WAIT		10
+#define SC_GETPID	11
+#define SC_SIGACTION	12
+#define SC_CHDIR	13
+#define SC_GETCWD	14
+#define SC_SOCKET	15
+#define SC_DUP		16
+#define SC_EVENT	17
+#define SC_KILL		18
+#define SC_TTY		19
+#define SC_MAX		20
+
+#define COUNT_SYSCALL(id) (syscall_counts()[(id)]++)
+
+#define TV_US(tv) ((unsigned long)(tv).tv_sec * 1000000UL + (tv).tv_usec)
+
+/*
+ * USDT probes for perf and bpftrace, provider "hsh". Each probe is a nop
+ * plus a .note.stapsdt entry describing it, the same encoding sys/sdt.h
+ * produces, so nothing is needed at run time and a probe costs one nop
+ * while no tracer is attached. Arguments are passed as 8-byte signed
+ * values; strings are passed as pointers (read them with str(argN)).
+ * Build with -DHSH_NO_PROBES, or on anything but x86-64, for no-op probes.
+ */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(HSH_NO_PROBES)
+#define USDT_NOTE(name, fmt) \
+	"990:	nop\n" \
+	".pushsection .note.stapsdt,\"?\",\"note\"\n" \
+	".balign 4\n" \
+	".4byte 992f-991f, 994f-993f, 3\n" \
+	"991:	.asciz \"stapsdt\"\n" \
+	"992:	.balign 4\n" \
+	"993:	.8byte 990b\n" \
+	".8byte _.stapsdt.base\n" \
+	".8byte 0\n" \
+	".asciz \"hsh\"\n" \
+	".asciz \"" #name "\"\n" \
+	".asciz \"" fmt "\"\n" \
+	"994:	.balign 4\n" \
+	".popsection\n" \
+	".ifndef _.stapsdt.base\n" \
+	".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+	".weak _.stapsdt.base\n" \
+	".hidden _.stapsdt.base\n" \
+	"_.stapsdt.base: .space 1\n" \
+	".size _.stapsdt.base, 1\n" \
+	".popsection\n" \
+	".endif\n"
+#define USDT_PROBE1(name, a1) \
+	__asm__ __volatile__(USDT_NOTE(name, "-8@%0") \
+			: : "nor" ((long)(a1)))
+#define USDT_PROBE2(name, a1, a2) \
+	__asm__ __volatile__(USDT_NOTE(name, "-8@%0 -8@%1") \
+			: : "nor" ((long)(a1)), "nor" ((long)(a2)))
+#define USDT_PROBE3(name, a1, a2, a3) \
+	__asm__ __volatile__(USDT_NOTE(name, "-8@%0 -8@%1 -8@%2") \
+			: : "nor" ((long)(a1)), "nor" ((long)(a2)), \
+			"nor" ((long)(a3)))
+#else
+#define USDT_PROBE1(name, a1) ((void)0)
+#define USDT_PROBE2(name, a1, a2) ((void)0)
+#define USDT_PROBE3(name, a1, a2, a3) ((void)0)
+#endif
+
+#define PH_READ		0
+#define PH_TOKENIZE	1
+#define PH_EXPAND	2
+#define PH_BUILTIN	3
+#define PH_PATH		4
+#define PH_SPAWN	5
+#define PH_MAX		6
+
+#define LAT_BUILTIN	0
+#define LAT_EXTERNAL	1
+#define LAT_PATH	2
+#define LAT_MAX		3
+
+#define HIST_SUB_BITS	3
+#define HIST_BUCKETS	(64 << HIST_SUB_BITS)
+
+#define PROF_TABLE_SIZE	1024
+
+#define SERVE_MAGIC	0x51485348U
+#define SERVE_FIELD_MAX	(1 << 20)
+#define SERVE_TIMEOUT	5
+#define SERVE_BACKOFF_MS	100
+
+#define TRACE_RING_SIZE	4096
+#define TRACE_MAGIC	"HSHTRC1"
+
+#define FUNC_TABLE_SIZE	64
+#define FUNC_DEPTH_MAX	256
+
 extern char **environ;
 
 /**
@@ -50,6 +168,387 @@ typedef struct liststr
 	struct liststr *next;
 } info_list;
 
+/**
+ * struct func_cmd - One pre-parsed command of a shell function body
+ * @argv: Words of the command, split once at definition time
+ * @quotes: QUOTE_* flags of each word of @argv, stored with it
+ * @text: Raw text of the command
+ * @type: Chain type linking this command to the previous one (CMD_type)
+ * @line: Input line the command was read from
+ * @next: Pointer to the next command of the body
+ *
+ * Function bodies are tokenized when the function is defined, so calling
+ * the function only copies @argv before expansion instead of re-lexing.
+ */
+typedef struct func_cmd
+{
+	char **argv;
+	char *quotes;
+	char *text;
+	int type;
+	unsigned int line;
+	struct func_cmd *next;
+} func_cmd_t;
+
+/**
+ * struct shell_func - A shell function stored in the function table
+ * @name: Name the function is invoked by
+ * @body: Pre-parsed list of commands making up the function body
+ * @next: Next function in the same hash bucket
+ */
+typedef struct shell_func
+{
+	char *name;
+	func_cmd_t *body;
+	struct shell_func *next;
+} shell_func_t;
+
+/**
+ * struct phase_stat - Timing aggregate of one interpreter phase
+ * @count: Number of times the phase ran
+ * @total_ns: Total time spent in the phase, in nanoseconds
+ * @max_ns: Longest single run of the phase, in nanoseconds
+ */
+typedef struct phase_stat
+{
+	unsigned long count;
+	unsigned long total_ns;
+	unsigned long max_ns;
+} phase_stat_t;
+
+/**
+ * struct cmd_usage - Resources used by a command or a set of commands
+ * @count: Number of commands accounted for
+ * @real_ns: Wall-clock time, in nanoseconds
+ * @user_us: User CPU time, in microseconds
+ * @sys_us: System CPU time, in microseconds
+ * @maxrss_kb: Largest resident set size, in kilobytes
+ */
+typedef struct cmd_usage
+{
+	unsigned long count;
+	unsigned long real_ns;
+	unsigned long user_us;
+	unsigned long sys_us;
+	long maxrss_kb;
+} cmd_usage_t;
+
+/**
+ * struct latency_hist - Log-bucketed latency histogram
+ * @count: Number of recorded values
+ * @max_ns: Largest recorded value, in nanoseconds
+ * @buckets: Counts per bucket; each power of two is split into
+ * 2^HIST_SUB_BITS linear sub-buckets, bounding the error to 12.5%
+ */
+typedef struct latency_hist
+{
+	unsigned long count;
+	unsigned long max_ns;
+	unsigned long buckets[HIST_BUCKETS];
+} latency_hist_t;
+
+/**
+ * struct prof_entry - Time attributed to one folded stack
+ * @stack: Frames from outermost to innermost, joined with ';'
+ * @ns: Self time of the stack, in nanoseconds
+ * @next: Pointer to the next entry of the same hash bucket
+ */
+typedef struct prof_entry
+{
+	char *stack;
+	unsigned long ns;
+	struct prof_entry *next;
+} prof_entry_t;
+
+/**
+ * struct trace_rec - One fixed-size record of the execution trace
+ * @start_ns: Monotonic time the command started at
+ * @dur_ns: Time the command took
+ * @line: Input line the command was read from
+ * @name_hash: djb2 hash of the command name
+ * @pid: Process that ran the command (the shell itself for builtins)
+ * @status: Exit status of the command
+ */
+typedef struct trace_rec
+{
+	unsigned long start_ns;
+	unsigned long dur_ns;
+	unsigned int line;
+	unsigned int name_hash;
+	int pid;
+	int status;
+} trace_rec_t;
+
+/**
+ * struct serve_req - Header of a --serve request
+ * @magic: SERVE_MAGIC
+ * @cmd_len: Length of the command text that follows
+ * @env_len: Length of the "NAME=VALUE\0" overrides after the command
+ * @cwd_len: Length of the working directory after the overrides, 0 to keep
+ * the server's
+ *
+ * The header travels with the client's stdin, stdout and stderr as
+ * SCM_RIGHTS, so the command writes straight to them. The reply is the
+ * exit status as an int.
+ */
+typedef struct serve_req
+{
+	unsigned int magic;
+	unsigned int cmd_len;
+	unsigned int env_len;
+	unsigned int cwd_len;
+} serve_req_t;
+
+/**
+ * struct zygote_req - Header of a --zygote spawn request
+ * @argv_len: Length of the program path and its arguments, each with its
+ * '\0', that follow
+ * @env_len: Length of the "NAME=VALUE\0" environment after them
+ * @cwd_len: Length of the working directory after the environment
+ * @line: Input line of the command, for an error from execve()
+ *
+ * Like a --serve request, the header carries the shell's stdin, stdout and
+ * stderr as SCM_RIGHTS.
+ */
+typedef struct zygote_req
+{
+	unsigned int argv_len;
+	unsigned int env_len;
+	unsigned int cwd_len;
+	unsigned int line;
+} zygote_req_t;
+
+#define ZYG_SPAWNED	1
+#define ZYG_EXITED	2
+
+/**
+ * struct zygote_msg - A message from the zygote to the shell
+ * @kind: ZYG_SPAWNED once a request was forked, ZYG_EXITED once a child
+ * was reaped
+ * @pid: The child, -1 if fork() failed
+ * @status: errno of a failed fork(), or the wait status of the child
+ * @usage: Resource usage of the child, for ZYG_EXITED
+ */
+typedef struct zygote_msg
+{
+	int kind;
+	pid_t pid;
+	int status;
+	struct rusage usage;
+} zygote_msg_t;
+
+#define CHILD_TIMER	((unsigned long)-1)
+#define CHILD_SIGCHLD	((unsigned long)-2)
+
+/**
+ * struct child - A child process owned by the child event loop
+ * @pid: Its process id
+ * @pidfd: A pidfd for it, or -1 when SIGCHLD tells of its exit
+ * @done: Set once it has been reaped
+ * @status: Its wait status, once @done
+ * @usage: Its resource usage, once @done
+ */
+typedef struct child
+{
+	pid_t pid;
+	int pidfd;
+	int done;
+	int status;
+	struct rusage usage;
+} child_t;
+
+/**
+ * struct glob_dir - A directory listing cached during glob expansion
+ * @path: The directory, "" for the working directory
+ * @names: The entry names, each '\0'-terminated, one after another
+ * @offsets: Offset of each entry in @names
+ * @count: Number of entries
+ * @mtime: Modification time of the directory in ns, for listings kept
+ * across commands
+ * @next: Next cached directory
+ *
+ * Listings are read once per command and shared by all its patterns.
+ * The names sit in one buffer so a 100k-entry directory costs two
+ * allocations instead of 100k.
+ */
+typedef struct glob_dir
+{
+	char *path;
+	char *names;
+	size_t *offsets;
+	int count;
+	unsigned long mtime;
+	struct glob_dir *next;
+} glob_dir_t;
+
+/**
+ * struct glob_res - Matches of a pattern
+ * @strs: The matching paths, malloc'd
+ * @count: Number of matches
+ * @max: Allocated size of @strs
+ */
+typedef struct glob_res
+{
+	char **strs;
+	int count;
+	int max;
+} glob_res_t;
+
+/**
+ * struct comp_cache - Command names offered by tab completion
+ * @path: The value of PATH the listings were read for
+ * @dirs: Listing of every PATH directory, with its mtime
+ * @names: The names of all @dirs, sorted, without duplicates
+ * @count: Number of @names
+ *
+ * A directory is read again only when its mtime changes, so completing
+ * a command costs one stat() per PATH directory and a binary search.
+ */
+typedef struct comp_cache
+{
+	char *path;
+	glob_dir_t *dirs;
+	char **names;
+	int count;
+} comp_cache_t;
+
+/**
+ * struct line_edit - State of the interactive line editor
+ * @buf: The line being edited, always '\0'-terminated
+ * @len: Number of bytes in @buf
+ * @max: Allocated size of @buf
+ * @pos: Byte offset of the cursor in @buf
+ * @done: 1 once the line is complete, -1 on end of input
+ * @hist: How many history entries back @buf was taken from, 0 if new
+ * @saved: The new line, kept while the history is browsed
+ * @searching: Set during a Ctrl-R search
+ * @failed: Set while the search query matches no entry
+ * @search_from: @hist when the search started, restored by Ctrl-G
+ * @query: The search query, '\0'-terminated
+ * @query_len: Number of bytes in @query
+ * @shown: What the terminal shows of the prompt and the line, or NULL
+ * @col: Column of the terminal cursor
+ * @out: Terminal output gathered while handling one read() of keys
+ * @out_len: Number of bytes in @out
+ *
+ * Keys only change @buf and @pos. edit_redraw() then compares the new
+ * text with @shown and rewrites the cells that differ.
+ */
+typedef struct line_edit
+{
+	char *buf;
+	size_t len;
+	size_t max;
+	size_t pos;
+	int done;
+	int hist;
+	char *saved;
+	int searching;
+	int failed;
+	int search_from;
+	char query[64];
+	size_t query_len;
+	char *shown;
+	size_t col;
+	char out[WRITE_BUF_SIZE];
+	size_t out_len;
+} line_edit_t;
+
+#define PMAP_CPU_WORDS	16
+
+/**
+ * struct pmap_job - One job of the pmap builtin
+ * @seq: Position of its item in the input
+ * @pid: The running command, 0 once it has been reaped
+ * @out_fd: Buffer holding its output with --keep-order, else -1
+ * @done: Set once it has been reaped
+ * @status: Its exit status, 128 plus the signal if it was killed
+ * @item: Its input line, or NULL if the entry is free
+ */
+typedef struct pmap_job
+{
+	unsigned long seq;
+	pid_t pid;
+	int out_fd;
+	int done;
+	int status;
+	char *item;
+} pmap_job_t;
+
+/**
+ * struct pmap - State of the pmap builtin
+ * @tmpl: The command template, with {} standing for the item
+ * @jobs: Maximum number of commands running at once
+ * @keep_order: Set by --keep-order
+ * @pin: Set by --pin
+ * @file: File to read items from, or NULL for standard input
+ * @slots: Number of entries in @ring
+ * @ring: Jobs running, or finished but not yet written out
+ * @running: Number of commands running
+ * @started: Number of jobs started
+ * @next_out: Sequence number of the next job to write out
+ * @failed: Number of jobs that failed
+ * @saved_out: Copy of the shell's stdout while job buffers replace it
+ * @cpus: CPUs the shell may run on, for --pin
+ * @cpu_count: Number of CPUs set in @cpus
+ */
+typedef struct pmap
+{
+	char **tmpl;
+	int jobs;
+	int keep_order;
+	int pin;
+	char *file;
+	int slots;
+	pmap_job_t *ring;
+	int running;
+	unsigned long started;
+	unsigned long next_out;
+	unsigned long failed;
+	int saved_out;
+	unsigned long cpus[PMAP_CPU_WORDS];
+	int cpu_count;
+} pmap_t;
+
+/**
+ * struct shell_io - Buffers owned by one interpreter
+ * @chain_buf: The ';' command chain buffer of get_input()
+ * @chain_pos: Start of the next command in @chain_buf
+ * @chain_end: End of the current command in @chain_buf
+ * @chain_len: Length of @chain_buf, 0 when it is used up
+ * @read_buf: Read buffer of get_stdin_line()
+ * @read_pos: Next unread byte of @read_buf
+ * @read_len: Number of valid bytes in @read_buf
+ * @out_buf: Standard output buffer of _putchar()
+ * @out_len: Number of bytes in @out_buf
+ * @err_buf: Standard error buffer of print_char()
+ * @err_len: Number of bytes in @err_buf
+ * @fd_buf: Buffer of print_char_file_desc()
+ * @fd_len: Number of bytes in @fd_buf
+ * @num_buf: Result of num_str_converter()
+ * @path_buf: Candidate path built by find_cmd_path()
+ * @syscalls: Counters bumped by COUNT_SYSCALL(), indexed by SC_* id
+ */
+typedef struct shell_io
+{
+	char *chain_buf;
+	size_t chain_pos;
+	size_t chain_end;
+	size_t chain_len;
+	char read_buf[READ_BUF_SIZE];
+	size_t read_pos;
+	size_t read_len;
+	char out_buf[WRITE_BUF_SIZE];
+	int out_len;
+	char err_buf[WRITE_BUF_SIZE];
+	int err_len;
+	char fd_buf[WRITE_BUF_SIZE];
+	int fd_len;
+	char num_buf[50];
+	char path_buf[PATH_MAX];
+	unsigned long syscalls[SC_MAX];
+} shell_io_t;
+
 /**
  * struct passinfo - A structure to hold information for a shell program
  * @arg: Argument string containing the input command
@@ -70,6 +569,53 @@ typedef struct liststr
  * @cmd_buf_type: Type of command chain (CMD_type: ||, &&, ;)
  * @readfd: File descriptor for reading input
  * @histcount: Count of command history
+ * @functions: Hash table of shell functions, allocated on first definition
+ * @pos_argv: Positional parameters of the running function ($0..$N)
+ * @pos_argc: Number of entries in @pos_argv
+ * @func_depth: Current function call nesting depth
+ * @cmd_str: Unread part of the "-c" command string, NULL when reading a fd
+ * @cmd_pending: Set when the ';' chain buffer holds more commands
+ * @read_pending: Bytes read from @readfd but not yet handed out as lines
+ * @env_ready: Set once @env has been built from the process environment
+ * @stdin_tty: Cached isatty(STDIN_FILENO), -1 until first asked
+ * @pid: Cached process id of the shell for $$, 0 until first asked
+ * @cmd_count: Number of commands dispatched so far
+ * @syscall_stats: Set by --syscall-stats to report syscall counts at exit
+ * @stats_file: File the per-phase timings are written to as JSON at exit
+ * @phases: Per-phase timings (PH_MAX entries), NULL when not collected
+ * @keep_shell: Set while the shell must outlive the current command
+ * @last_usage: Resources used by the last external or timed command
+ * @total_usage: Resources used by all external commands of the session
+ * @latency: Latency histograms (LAT_MAX entries), allocated on first use
+ * @src_line: Number of input lines read so far, blank ones included
+ * @script_name: Path of the script file being run, or NULL
+ * @profile_file: File to write the --profile folded stacks to, or NULL
+ * @profile: Hash table (PROF_TABLE_SIZE buckets) of profiled stacks
+ * @prof_stack: Folded stack of the command being profiled
+ * @prof_len: Length of @prof_stack
+ * @prof_child_ns: Time spent in nested commands of the current frame
+ * @cmd_line: Input line of the command being dispatched
+ * @child_pid: Process id of the last external command, 0 if none
+ * @trace_file: File the trace ring buffer is dumped to, or NULL
+ * @trace: Trace ring buffer of TRACE_RING_SIZE records, or NULL
+ * @trace_count: Number of trace records written so far
+ * @io: Input and output buffers of this interpreter
+ * @embedded: Set for hsh_new() interpreters, which must never exec in place
+ * @serve_path: Socket given to --serve, or NULL
+ * @client_path: Socket given to --client, or NULL
+ * @zygote: Set by --zygote
+ * @zygote_fd: The shell's end of the zygote socket pair
+ * @zygote_pid: Process id of the zygote, 0 if there is none
+ * @children: Children watched by the child event loop
+ * @child_count: Number of entries in @children
+ * @child_max: Allocated size of @children
+ * @epoll_fd: epoll instance of the child event loop, or -1
+ * @timer_fd: Deadline timer of the child event loop, or -1
+ * @autobatch: Set by "set -o autobatch"
+ * @batch_jobs: Parallel batches allowed by the batch prefix, 0 outside it
+ * @env_bytes: execve() size of the environment, 0 until measured
+ * @argq: QUOTE_* flags of each word of @argv while it is being expanded
+ * @completion: PATH command names for tab completion, or NULL
  *
  * The `passinfo` struct holds various fields and pointers to manage
  * information related to a shell program. It contains details about
@@ -96,11 +642,62 @@ typedef struct passinfo
 	int cmd_buf_type;
 	int readfd;
 	int histcount;
+
+	shell_func_t **functions;
+	char **pos_argv;
+	int pos_argc;
+	int func_depth;
+	char *cmd_str;
+	int cmd_pending;
+	size_t read_pending;
+	int env_ready;
+	int stdin_tty;
+	pid_t pid;
+	unsigned long cmd_count;
+	int syscall_stats;
+	char *stats_file;
+	phase_stat_t *phases;
+	int keep_shell;
+	cmd_usage_t last_usage;
+	cmd_usage_t total_usage;
+	latency_hist_t *latency;
+	unsigned int src_line;
+	char *script_name;
+	char *profile_file;
+	prof_entry_t **profile;
+	char *prof_stack;
+	size_t prof_len;
+	unsigned long prof_child_ns;
+	unsigned int cmd_line;
+	pid_t child_pid;
+	char *trace_file;
+	trace_rec_t *trace;
+	unsigned long trace_count;
+	shell_io_t io;
+	int embedded;
+	char *serve_path;
+	char *client_path;
+	int zygote;
+	int zygote_fd;
+	pid_t zygote_pid;
+	child_t *children;
+	int child_count;
+	int child_max;
+	int epoll_fd;
+	int timer_fd;
+	int autobatch;
+	int batch_jobs;
+	size_t env_bytes;
+	char *argq;
+	comp_cache_t *completion;
 } info_t;
 
 #define INFO_INIT \
 {NULL, NULL, NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, \
-	0, 0, 0}
+	0, 0, 0, NULL, NULL, 0, 0, NULL, 0, 0, 0, -1, 0, 0, \
+	0, NULL, NULL, 0, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, \
+	NULL, 0, NULL, NULL, NULL, NULL, 0, 0, 0, 0, NULL, NULL, 0, {0}, \
+	0, NULL, NULL, 0, -1, 0, NULL, 0, 0, -1, -1, 0, 0, 0, NULL, NULL}
 
 /**
  * struct builtin - A structure to hold information about built-in commands
@@ -117,14 +714,80 @@ typedef struct builtin
 	int (*func)(info_t *);
 } builtin_table;
 
+builtin_table *builtin_list(void);
 
+/**
+ * struct shell_opt - A structure describing a long command-line option
+ * @name: The option as typed, e.g. "--syscall-stats"
+ * @has_arg: 1 if the option consumes the next argument, 0 otherwise
+ * @func: Function applying the option, given its argument (or NULL)
+ */
+typedef struct shell_opt
+{
+	char *name;
+	int has_arg;
+	int (*func)(info_t *, char *);
+} shell_opt_table;
+
+
+int hsh_main(int, char **);
 int hsh_loop(info_t *, char **);
+int run_commands(info_t *, char **);
+int hsh_eval(info_t *, const char *);
+
+info_t *shell_ctx(void);
+info_t *use_shell_ctx(info_t *);
+info_t *hsh_new(char *);
+void hsh_free(info_t *);
+
+int run_server(info_t *);
+int serve_listen(char *);
+int serve_accept(info_t *, int);
+int serve_request(info_t *, int);
+int recv_request(int, serve_req_t *, int *);
+void apply_request(info_t *, char *, unsigned int, char *);
+
+int socket_addr(char *, struct sockaddr_un *);
+int run_client(info_t *, int, char **);
+char *build_request(serve_req_t *, int, char **);
+int send_request(int, serve_req_t *, char *);
+
+int send_fds(int, void *, size_t);
+int recv_fds(int, void *, size_t, int *);
+int read_full(int, char *, size_t);
+int write_full(int, char *, size_t);
+
+void start_zygote(info_t *);
+void zygote_loop(int);
+int zygote_spawn(int, sigset_t *);
+void zygote_exec(char *, zygote_req_t *, int *, sigset_t *);
+void zygote_reap(int);
+pid_t zygote_run(info_t *, struct rusage *);
+void zygote_lost(info_t *, pid_t);
+int zygote_send(info_t *);
+char **split_block(char *, unsigned int);
+
+int child_loop_init(info_t *);
+int child_watch(info_t *, pid_t);
+int child_wait(info_t *, pid_t, unsigned long, child_t *);
+int child_find(info_t *, pid_t);
+void child_event(info_t *, struct epoll_event *);
+void child_reap(child_t *);
+int *sigchld_pipe(void);
+void sigchld_handler(int);
+int sigchld_fallback(info_t *);
+void child_loop_free(info_t *);
 int search_builtin(info_t *);
 void search_exe_cmd(info_t *);
 void fork_execute_cmd(info_t *);
+pid_t fork_child(info_t *);
+pid_t fork_wait(info_t *, struct rusage *);
+void exec_failed(info_t *, char *);
+int exec_status(int);
+int dispatch_cmd(info_t *);
 
 int is_exe_cmd(info_t *, char *);
-char *duplicate_chars(char *, int, int);
+char *duplicate_chars(info_t *, char *, int, int);
 char *find_cmd_path(info_t *, char *, char *);
 
 int print_hsh_alias(info_list *node);
@@ -155,13 +818,56 @@ char *_strchr(char *, char);
 char **strtow(char *, char *);
 char **strtow2(char *, char);
 
+size_t quote_end(char *, size_t);
+size_t word_end(char *);
+int quote_flag(char);
+int unquote_word(char *, char *);
+char **split_words(char *, char **);
+char *copy_word(char *, size_t, char *);
+char *glob_unescape(char *);
+
+int edit_line(info_t *, char **, size_t *);
+int tty_raw(struct termios *, int);
+void edit_read(info_t *, line_edit_t *);
+size_t edit_key(info_t *, line_edit_t *, char *, size_t);
+size_t edit_escape(info_t *, line_edit_t *, char *, size_t);
+int edit_insert(line_edit_t *, char *, size_t);
+void edit_delete(line_edit_t *, size_t, size_t);
+void edit_set(line_edit_t *, char *);
+size_t utf8_back(char *, size_t);
+size_t utf8_cols(char *, size_t);
+void edit_out(line_edit_t *, char *, size_t);
+void edit_redraw(line_edit_t *);
+char *edit_view(line_edit_t *, size_t *);
+void edit_move(line_edit_t *, size_t);
+size_t utf8_next(char *, size_t);
+char *hist_entry(info_t *, int);
+int edit_history(info_t *, line_edit_t *, int);
+int search_find(info_t *, line_edit_t *, int);
+int edit_search(info_t *, line_edit_t *, unsigned char);
+int *sigint_pipe(void);
+int sigint_taken(void);
+
+void complete_line(info_t *, line_edit_t *);
+void complete_cmds(info_t *, char *, glob_res_t *);
+void complete_files(char *, glob_res_t *);
+void complete_apply(line_edit_t *, char *, glob_res_t *);
+void complete_list(line_edit_t *, glob_res_t *);
+comp_cache_t *comp_refresh(info_t *);
+int comp_read_dir(comp_cache_t *, char *);
+void comp_rebuild(comp_cache_t *);
+void comp_search(comp_cache_t *, char *, glob_res_t *);
+void comp_free(info_t *);
+
 char *_memset(char *, char, unsigned int);
 void free_ptr_array(char **);
 void *_realloc(void *, unsigned int, unsigned int);
 
 int free_ptr(void **);
+char **dup_str_array(char **);
 
 int is_interactive(info_t *);
+pid_t shell_pid(info_t *);
 int is_delimiter(char, char *);
 int is_alpha(int);
 int convert_str_to_int(char *);
@@ -176,6 +882,85 @@ int hsh_exit(info_t *);
 int hsh_cd(info_t *);
 int hsh_help(info_t *);
 
+int input_at_eof(info_t *);
+int is_last_cmd(info_t *);
+void replace_shell(info_t *, char *, char **);
+int hsh_exec(info_t *);
+int dispatch_rest(info_t *, int);
+
+void record_usage(info_t *, struct rusage *, unsigned long);
+char *format_usec(char *, unsigned long);
+void print_usage(char *, cmd_usage_t *, int);
+int hsh_time(info_t *);
+int hsh_times(info_t *);
+
+int init_trace(info_t *);
+unsigned int trace_hash(char *);
+void trace_record(info_t *, unsigned long, unsigned int, unsigned int);
+int write_trace(info_t *);
+int decode_trace(info_t *, char *);
+void print_trace_rec(trace_rec_t *, unsigned long, unsigned long);
+
+info_t *trace_owner(info_t *);
+void sigusr1_handler(int);
+void catch_signal(int);
+
+int profile_dispatch(info_t *, char *, unsigned int);
+int prof_push(info_t *, char *, unsigned int);
+void prof_add(info_t *, unsigned long);
+int write_profile(info_t *);
+
+int hist_index(unsigned long);
+unsigned long hist_upper(int);
+void record_latency(info_t *, int, unsigned long);
+unsigned long hist_percentile(latency_hist_t *, int);
+
+void print_latency(char *, latency_hist_t *);
+int hsh_stats(info_t *);
+
+int hsh_timeout(info_t *);
+int parse_duration(char *, unsigned long *);
+int parse_signal(char *);
+int timeout_run(info_t *, int, unsigned long *, int);
+int timeout_wait(info_t *, pid_t, unsigned long *, int, child_t *);
+
+size_t argv_bytes(char **, int);
+int batch_fixed(char **);
+int run_batches(info_t *);
+int batch_run(info_t *, int, size_t);
+int batch_spawn(info_t *, char **, int, int, int);
+int batch_next(info_t *, int, size_t);
+int hsh_batch(info_t *);
+int hsh_set(info_t *);
+
+int expand_globs(info_t *);
+int is_glob_arg(info_t *, int);
+int glob_walk(glob_dir_t **, char *, char *, glob_res_t *);
+int has_glob(char *, size_t);
+int glob_add(glob_res_t *, char *, char *);
+int glob_match(char *, char *);
+char *match_one(char *, char);
+glob_dir_t *glob_list(glob_dir_t **, char *);
+void glob_cache_free(glob_dir_t *);
+int glob_cmp(const void *, const void *);
+
+int hsh_pmap(info_t *);
+int pmap_parse(info_t *, pmap_t *);
+void pmap_run(info_t *, pmap_t *, info_t *);
+info_t *pmap_reader(info_t *, pmap_t *);
+int pmap_start(info_t *, pmap_t *, char *);
+void pmap_reap(info_t *, pmap_t *);
+void pmap_flush(info_t *, pmap_t *, pmap_job_t *);
+char **pmap_argv(char **, char *);
+char *pmap_subst(char *, char *);
+void pmap_pin(pmap_t *, pid_t, unsigned long);
+int pmap_buffer(void);
+void pmap_copy(int);
+
+char *usage_var_value(info_t *, char *, char *);
+int replace_usage_var(info_t *, int);
+int replace_env_var(info_t *, int);
+
 int hsh_history(info_t *);
 int hsh_alias(info_t *);
 
@@ -183,8 +968,35 @@ ssize_t get_input(info_t *);
 int get_stdin_line(info_t *, char **, size_t *);
 ssize_t read_buffer(info_t *, char *, size_t *);
 ssize_t input_buffer(info_t *, char **, size_t *);
+ssize_t define_functions(info_t *, char **, ssize_t);
 void sigint_handler(__attribute__((unused)) int signal_num);
 
+void setup_signals(void);
+
+int parse_shell_opts(info_t *, int, char **);
+int opt_syscall_stats(info_t *, char *);
+int opt_stats_json(info_t *, char *);
+int opt_profile(info_t *, char *);
+int opt_trace(info_t *, char *);
+int opt_decode_trace(info_t *, char *);
+int opt_serve(info_t *, char *);
+int opt_client(info_t *, char *);
+int opt_zygote(info_t *, char *);
+
+unsigned long now_ns(void);
+int init_phase_stats(info_t *);
+unsigned long phase_start(info_t *);
+void phase_end(info_t *, int, unsigned long);
+int write_stats_json(info_t *);
+
+unsigned long *syscall_counts(void);
+void report_syscall_stats(info_t *);
+void report_stats(info_t *);
+
+int set_cmd_string(info_t *, int, char **);
+int get_string_line(info_t *, char **, size_t *);
+int read_input_line(info_t *, char **, size_t *);
+
 void clear_info_list(info_t *);
 void set_info_list(info_t *, char **);
 void free_info_list(info_t *, int);
@@ -194,6 +1006,7 @@ int display_env_var(info_t *);
 int update_env_var(info_t *);
 int clear_all_env_var(info_t *);
 int initialize_env_list(info_t *);
+info_list *get_env_list(info_t *);
 
 char **get_environ(info_t *);
 int _unset_env(info_t *, char *);
@@ -204,6 +1017,7 @@ int write_history_to_file(info_t *info_struct);
 int read_command_history(info_t *info_struct);
 int add_to_history_list(info_t *info_struct, char *buffer, int line_count);
 int add_numbering_to_history(info_t *info_struct);
+int history_start(char *, ssize_t);
 
 info_list *add_node(info_list **, const char *, int);
 info_list *add_node_end(info_list **, const char *, int);
@@ -223,5 +1037,23 @@ int replace_cmd_with_alias(info_t *);
 int replace_cmd_argv(info_t *);
 int replace_string(char **, char *);
 
+char *parse_func_header(char *, char **);
+char *find_body_end(char *, char **);
+char *read_func_line(info_t *, char *);
+char *define_function(info_t *, char *, char *);
+func_cmd_t *parse_func_body(char *, unsigned int);
+
+unsigned int hash_func_name(char *);
+shell_func_t *find_function(info_t *, char *);
+int add_function(info_t *, char *, func_cmd_t *);
+void free_func_body(func_cmd_t *);
+void free_functions(info_t *);
+
+func_cmd_t *new_func_cmd(char *, int);
+int search_function(info_t *);
+int run_function(info_t *, shell_func_t *);
+int run_func_cmd(info_t *, char *, func_cmd_t *);
+int replace_positional(info_t *, int);
+
 #endif
 
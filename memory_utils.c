@@ -114,3 +114,36 @@ int free_ptr(void **d_ptr)
 	}
 	return (0);
 }
+
+/**
+ * dup_str_array - Duplicates a NULL-terminated array of strings.
+ * @array_ptr: The array to duplicate.
+ *
+ * Return: A newly allocated deep copy of @array_ptr, or NULL on failure.
+ */
+char **dup_str_array(char **array_ptr)
+{
+	char **copy;
+	int count, size = 0;
+
+	if (!array_ptr)
+		return (NULL);
+	while (array_ptr[size])
+		size++;
+
+	copy = malloc(sizeof(char *) * (size + 1));
+	if (!copy)
+		return (NULL);
+	for (count = 0; count < size; count++)
+	{
+		copy[count] = _strdup(array_ptr[count]);
+		if (!copy[count])
+		{
+			copy[count] = NULL;
+			free_ptr_array(copy);
+			return (NULL);
+		}
+	}
+	copy[size] = NULL;
+	return (copy);
+}
@@ -0,0 +1,124 @@
+#include "main.h"
+
+#include <time.h>
+
+/**
+ * now_ns - Reads the monotonic clock.
+ *
+ * Return: The current CLOCK_MONOTONIC time in nanoseconds.
+ */
+unsigned long now_ns(void)
+{
+	struct timespec time_spec;
+
+	clock_gettime(CLOCK_MONOTONIC, &time_spec);
+	return ((unsigned long)time_spec.tv_sec * 1000000000UL
+			+ time_spec.tv_nsec);
+}
+
+/**
+ * init_phase_stats - Enables per-phase timing if a report was requested.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The report file comes from --stats-json, or else from the
+ * HSH_STATS environment variable. Without either, no timing table is
+ * allocated and every phase_start() call returns without reading the
+ * clock.
+ *
+ * Return: 0 on success, 1 on memory allocation failure.
+ */
+int init_phase_stats(info_t *info_struct)
+{
+	unsigned int size = sizeof(phase_stat_t) * PH_MAX;
+
+	if (!info_struct->stats_file)
+		info_struct->stats_file = get_env_var(info_struct, "HSH_STATS=");
+	if (!info_struct->stats_file)
+		return (0);
+
+	info_struct->phases = malloc(size);
+	if (!info_struct->phases)
+		return (1);
+	_memset((void *)info_struct->phases, 0, size);
+	return (0);
+}
+
+/**
+ * phase_start - Marks the start of a timed phase.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Return: The start time to hand to phase_end(), 0 when timing is off.
+ */
+unsigned long phase_start(info_t *info_struct)
+{
+	return (info_struct->phases ? now_ns() : 0);
+}
+
+/**
+ * phase_end - Records one run of a timed phase.
+ * @info_struct: Pointer to the info_t structure.
+ * @phase: The PH_* phase that just finished.
+ * @start: The value returned by phase_start().
+ */
+void phase_end(info_t *info_struct, int phase, unsigned long start)
+{
+	phase_stat_t *stat;
+	unsigned long elapsed;
+
+	if (!info_struct->phases)
+		return;
+
+	elapsed = now_ns() - start;
+	stat = &info_struct->phases[phase];
+	stat->count++;
+	stat->total_ns += elapsed;
+	if (elapsed > stat->max_ns)
+		stat->max_ns = elapsed;
+}
+
+/**
+ * write_stats_json - Writes the per-phase timings to the stats file.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The report is a single JSON object, for example
+ * {"commands":3,"phases":{"read":{"count":4,"total_ns":..,"max_ns":..},..}}
+ *
+ * Return: 1 on success, -1 on failure.
+ */
+int write_stats_json(info_t *info_struct)
+{
+	char *names[] = {"read", "tokenize", "expand", "builtin", "path",
+		"spawn"};
+	int file_desc, phase;
+
+	COUNT_SYSCALL(SC_OPEN);
+	file_desc = open(info_struct->stats_file, O_CREAT | O_TRUNC | O_WRONLY,
+			0644);
+	if (file_desc == -1)
+		return (-1);
+
+	print_string_file_desc("{\"commands\":", file_desc);
+	print_string_file_desc(num_str_converter(info_struct->cmd_count, 10, 0),
+			file_desc);
+	print_string_file_desc(",\"phases\":{", file_desc);
+	for (phase = 0; phase < PH_MAX; phase++)
+	{
+		print_string_file_desc(phase ? ",\"" : "\"", file_desc);
+		print_string_file_desc(names[phase], file_desc);
+		print_string_file_desc("\":{\"count\":", file_desc);
+		print_string_file_desc(num_str_converter(
+					info_struct->phases[phase].count, 10, 0), file_desc);
+		print_string_file_desc(",\"total_ns\":", file_desc);
+		print_string_file_desc(num_str_converter(
+					info_struct->phases[phase].total_ns, 10, 0), file_desc);
+		print_string_file_desc(",\"max_ns\":", file_desc);
+		print_string_file_desc(num_str_converter(
+					info_struct->phases[phase].max_ns, 10, 0), file_desc);
+		print_char_file_desc('}', file_desc);
+	}
+	print_string_file_desc("}}\n", file_desc);
+	print_char_file_desc(BUF_FLUSH, file_desc);
+	COUNT_SYSCALL(SC_CLOSE);
+	close(file_desc);
+	return (1);
+}
@@ -0,0 +1,142 @@
+#include "main.h"
+
+/**
+ * pmap_start - Starts the job of one item.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The pmap state.
+ * @item: The item; it belongs to the job from now on.
+ *
+ * Description: With --keep-order the command's stdout is an unlinked
+ * temporary file, written out once every earlier job has been.
+ *
+ * Return: 0 if the job was started, -1 otherwise.
+ */
+int pmap_start(info_t *info_struct, pmap_t *pm, char *item)
+{
+	pmap_job_t *job = pm->ring;
+	char **saved_argv = info_struct->argv, **argv;
+
+	while (job->item)
+		job++;
+	argv = pmap_argv(pm->tmpl, item);
+	if (!argv)
+		return (-1);
+	info_struct->argv = argv;
+	info_struct->path = find_cmd_path(info_struct,
+			get_env_var(info_struct, "PATH="), argv[0]);
+	if (!info_struct->path && _strchr(argv[0], '/'))
+		info_struct->path = argv[0];
+	job->out_fd = pm->keep_order ? pmap_buffer() : -1;
+	if (job->out_fd != -1 && pm->saved_out == -1)
+		pm->saved_out = fcntl(1, F_DUPFD_CLOEXEC, 3);
+	COUNT_SYSCALL(SC_DUP);
+	if (job->out_fd != -1)
+		dup2(job->out_fd, 1);
+	job->pid = info_struct->path ? fork_child(info_struct) : -1;
+	if (job->out_fd != -1)
+		dup2(pm->saved_out, 1);
+	if (!info_struct->path)
+		print_error(info_struct, "not found\n");
+	info_struct->argv = saved_argv;
+	free_ptr_array(argv);
+	if (job->pid == -1 || child_watch(info_struct, job->pid) == -1)
+		job->status = 127, job->pid = 0, job->done = 1;
+	else if (pm->pin && pm->cpu_count)
+		pmap_pin(pm, job->pid, pm->started);
+	job->item = item;
+	job->seq = pm->started++;
+	pm->running += !job->done;
+	pmap_flush(info_struct, pm, job->done ? job : NULL);
+	return (0);
+}
+
+/**
+ * pmap_reap - Waits for one running job to finish.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The pmap state.
+ */
+void pmap_reap(info_t *info_struct, pmap_t *pm)
+{
+	child_t child;
+	int index;
+
+	if (child_wait(info_struct, -1, 0, &child) != 0)
+	{
+		pm->running = 0; /* nothing watched: should not happen */
+		return;
+	}
+	for (index = 0; index < pm->slots; index++)
+		if (pm->ring[index].item && pm->ring[index].pid == child.pid)
+			break;
+	if (index == pm->slots)
+		return;
+	pm->running--;
+	pm->ring[index].pid = 0;
+	pm->ring[index].done = 1;
+	pm->ring[index].status = WIFSIGNALED(child.status)
+		? 128 + WTERMSIG(child.status) : WEXITSTATUS(child.status);
+	pmap_flush(info_struct, pm, &pm->ring[index]);
+}
+
+/**
+ * pmap_flush - Retires finished jobs.
+ * @info_struct: Pointer to the info structure.
+ * @pm: The pmap state.
+ * @job: The job that just finished, or NULL.
+ *
+ * Description: Without --keep-order @job is retired right away. With it,
+ * jobs are retired in input order, each writing out its buffered output,
+ * as long as the next one in line has finished. A failed job is reported
+ * on standard error as it is retired.
+ */
+void pmap_flush(info_t *info_struct, pmap_t *pm, pmap_job_t *job)
+{
+	int index = 0;
+
+	while (job || (pm->keep_order && index < pm->slots))
+	{
+		if (!job)
+			job = &pm->ring[index++];
+		if (!job->item || !job->done
+				|| (pm->keep_order && job->seq != pm->next_out))
+		{
+			job = NULL;
+			continue;
+		}
+		if (job->out_fd != -1)
+			pmap_copy(job->out_fd);
+		if (job->status)
+		{
+			pm->failed++;
+			print_error(info_struct, "failed with status ");
+			print_string(num_str_converter(job->status, 10, 0));
+			print_string(": ");
+			print_string(job->item);
+			print_char('\n');
+			print_char(BUF_FLUSH);
+		}
+		free_ptr((void **)&job->item);
+		job->done = 0;
+		pm->next_out++;
+		job = NULL;
+		index = 0;
+	}
+}
+
+/**
+ * pmap_copy - Writes out and closes the output buffer of a job.
+ * @fd: The buffer.
+ */
+void pmap_copy(int fd)
+{
+	char buffer[READ_BUF_SIZE];
+	ssize_t got;
+
+	COUNT_SYSCALL(SC_LSEEK);
+	lseek(fd, 0, SEEK_SET);
+	while ((got = read(fd, buffer, sizeof(buffer))) > 0)
+		if (write_full(1, buffer, got) == -1)
+			break;
+	COUNT_SYSCALL(SC_CLOSE);
+	close(fd);
+}
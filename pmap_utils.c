@@ -0,0 +1,111 @@
+#include "main.h"
+
+/**
+ * pmap_argv - Builds the argument vector of one pmap job.
+ * @tmpl: The command template.
+ * @item: The item.
+ *
+ * Return: A malloc'd argv of malloc'd strings, with every {} replaced by
+ * @item, or @item appended if no argument holds a {}; NULL on failure.
+ */
+char **pmap_argv(char **tmpl, char *item)
+{
+	int count, index, found = 0, failed = 0;
+	char **argv, *pos;
+
+	for (count = 0; tmpl[count]; count++)
+		for (pos = tmpl[count]; (pos = _strchr(pos, '{')); pos++)
+			found |= pos[1] == '}';
+	argv = malloc(sizeof(char *) * (count + 2));
+	if (!argv)
+		return (NULL);
+	for (index = 0; index < count; index++)
+		failed |= !(argv[index] = pmap_subst(tmpl[index], item));
+	argv[count] = found ? NULL : _strdup(item);
+	failed |= !found && !argv[count];
+	argv[count + 1] = NULL;
+	if (!failed)
+		return (argv);
+	for (index = 0; index <= count; index++)
+		free(argv[index]);
+	free(argv);
+	return (NULL);
+}
+
+/**
+ * pmap_subst - Replaces every {} in an argument with the item.
+ * @arg: The template argument.
+ * @item: The item.
+ *
+ * Return: A malloc'd string, or NULL on failure.
+ */
+char *pmap_subst(char *arg, char *item)
+{
+	int len = 0, item_len = _strlen(item);
+	char *pos, *result;
+
+	for (pos = arg; *pos; pos++)
+		len += (pos[0] == '{' && pos[1] == '}') ? (pos++, item_len) : 1;
+	result = malloc(len + 1);
+	if (!result)
+		return (NULL);
+	for (len = 0, pos = arg; *pos; pos++)
+	{
+		if (pos[0] == '{' && pos[1] == '}')
+		{
+			_strcpy(result + len, item);
+			len += item_len;
+			pos++;
+		}
+		else
+			result[len++] = *pos;
+	}
+	result[len] = '\0';
+	return (result);
+}
+
+/**
+ * pmap_pin - Pins a job to one of the shell's CPUs.
+ * @pm: The pmap state.
+ * @pid: The job's command.
+ * @seq: The job's sequence number; jobs go round-robin over the CPUs.
+ *
+ * Description: The affinity is set from the shell right after fork(), so
+ * the command may run its first instructions on another CPU.
+ */
+void pmap_pin(pmap_t *pm, pid_t pid, unsigned long seq)
+{
+	unsigned long mask[PMAP_CPU_WORDS], bits = 8 * sizeof(long);
+	int cpu, skip = seq % pm->cpu_count;
+
+	for (cpu = 0; cpu < (int)(PMAP_CPU_WORDS * bits); cpu++)
+		if ((pm->cpus[cpu / bits] >> (cpu % bits) & 1) && !skip--)
+			break;
+	_memset((char *)mask, 0, sizeof(mask));
+	mask[cpu / bits] = 1UL << (cpu % bits);
+	COUNT_SYSCALL(SC_EVENT);
+	syscall(SYS_sched_setaffinity, pid, sizeof(mask), mask);
+}
+
+/**
+ * pmap_buffer - Creates the output buffer of a --keep-order job.
+ *
+ * Return: An unlinked temporary file under $TMPDIR or /tmp, or -1.
+ */
+int pmap_buffer(void)
+{
+	char path[PATH_MAX], *dir = getenv("TMPDIR");
+	int fd;
+
+	if (!dir || !*dir || _strlen(dir) > PATH_MAX - 32)
+		dir = "/tmp";
+	_strcpy(path, dir);
+	_strcat(path, "/hsh-pmap-XXXXXX");
+	COUNT_SYSCALL(SC_OPEN);
+	fd = mkstemp(path);
+	if (fd == -1)
+		return (-1);
+	unlink(path);
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+	return (fd);
+}
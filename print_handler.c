@@ -33,22 +33,24 @@ void print_string(char *str)
  * Description: This function prints the given character to the standard
  * error stream. The characters are buffered until the buffer is full
  * or a special character (BUF_FLUSH) is encountered, at which point
- * the buffer is flushed to the standard error stream. The function
- * always returns 1 to indicate success.
+ * the buffer is flushed to the standard error stream. An empty buffer is
+ * never flushed, so no empty write() is issued. The buffer belongs to the
+ * current interpreter (shell_ctx()). The function always returns 1 to
+ * indicate success.
  */
 int print_char(char c)
 {
-	static char buffer[WRITE_BUF_SIZE];
-	static int count;
+	shell_io_t *io = &(shell_ctx()->io);
 
-	if (c == BUF_FLUSH || count >= WRITE_BUF_SIZE)
+	if ((c == BUF_FLUSH || io->err_len >= WRITE_BUF_SIZE) && io->err_len)
 	{
-		write(2, buffer, count); /* Flush the buffer */
-		count = 0;
+		COUNT_SYSCALL(SC_WRITE);
+		write(2, io->err_buf, io->err_len); /* Flush the buffer */
+		io->err_len = 0;
 	}
 
 	if (c != BUF_FLUSH)
-		buffer[count++] = c; /* Add character to buffer */
+		io->err_buf[io->err_len++] = c; /* Add character to buffer */
 
 	return (1); /* Return 1 to indicate success */
 }
@@ -68,18 +70,18 @@ int print_char(char c)
  */
 int print_char_file_desc(char c, int file_desc)
 {
-	static int count;
-	static char buffer[WRITE_BUF_SIZE];
+	shell_io_t *io = &(shell_ctx()->io);
 
-	if (c == BUF_FLUSH || count >= WRITE_BUF_SIZE)
+	if ((c == BUF_FLUSH || io->fd_len >= WRITE_BUF_SIZE) && io->fd_len)
 	{
-		write(file_desc, buffer, count); /* Flush the buffer*/
-		count = 0;
+		COUNT_SYSCALL(SC_WRITE);
+		write(file_desc, io->fd_buf, io->fd_len); /* Flush the buffer*/
+		io->fd_len = 0;
 	}
 
 	if (c != BUF_FLUSH)
 	{
-		buffer[count++] = c; /* Add character to buffer */
+		io->fd_buf[io->fd_len++] = c; /* Add character to buffer */
 	}
 
 	return (1); /* Return 1 to indicate success */
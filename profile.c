@@ -0,0 +1,155 @@
+#include "main.h"
+
+/**
+ * profile_dispatch - Runs a command, charging its time to a source line.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: Script or function name of the frame.
+ * @line: Input line the command was read from.
+ *
+ * Description: Without --profile, or for an empty line, this is just
+ * dispatch_cmd(). Otherwise the frame "name:line" is pushed on the folded
+ * stack for the duration of the command, and its wall time, child wait
+ * included, minus the time of the commands nested in it (function bodies)
+ * is added to that stack.
+ *
+ * Return: The result of dispatch_cmd().
+ */
+int profile_dispatch(info_t *info_struct, char *name, unsigned int line)
+{
+	unsigned long start, elapsed, saved_child = info_struct->prof_child_ns;
+	int saved_len, result;
+
+	info_struct->cmd_line = line;
+	if (!info_struct->profile_file || !info_struct->argv
+			|| !info_struct->argv[0] || !*info_struct->argv[0])
+		return (dispatch_cmd(info_struct));
+
+	saved_len = prof_push(info_struct, name, line);
+	info_struct->prof_child_ns = 0;
+	start = now_ns();
+	result = dispatch_cmd(info_struct);
+	elapsed = now_ns() - start;
+	if (saved_len != -1)
+	{
+		prof_add(info_struct, elapsed - info_struct->prof_child_ns);
+		info_struct->prof_stack[saved_len] = '\0';
+		info_struct->prof_len = saved_len;
+	}
+	info_struct->prof_child_ns = saved_child + elapsed;
+	return (result);
+}
+
+/**
+ * prof_push - Appends a frame to the folded stack.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: Script or function name of the frame.
+ * @line: Input line of the frame.
+ *
+ * Return: The stack length before the push, or -1 on failure.
+ */
+int prof_push(info_t *info_struct, char *name, unsigned int line)
+{
+	char *number = num_str_converter(line, 10, 0);
+	size_t len = info_struct->prof_len;
+	size_t need = len + _strlen(name) + _strlen(number) + 3;
+	char *stack;
+
+	stack = _realloc(info_struct->prof_stack, len ? len + 1 : 0, need);
+	if (!stack)
+		return (-1);
+	if (!len)
+		*stack = '\0';
+	else
+		_strcat(stack, ";");
+	_strcat(stack, name);
+	_strcat(stack, ":");
+	_strcat(stack, number);
+	info_struct->prof_stack = stack;
+	info_struct->prof_len = _strlen(stack);
+	return (len);
+}
+
+/**
+ * prof_add - Adds self time to the current folded stack.
+ * @info_struct: Pointer to the info_t structure.
+ * @ns: Time to add, in nanoseconds.
+ */
+void prof_add(info_t *info_struct, unsigned long ns)
+{
+	unsigned long hash = 5381;
+	char *str = info_struct->prof_stack;
+	prof_entry_t *entry;
+
+	if (!info_struct->profile)
+	{
+		info_struct->profile = malloc(sizeof(prof_entry_t *) * PROF_TABLE_SIZE);
+		if (!info_struct->profile)
+			return;
+		_memset((void *)info_struct->profile, 0,
+				sizeof(prof_entry_t *) * PROF_TABLE_SIZE);
+	}
+	while (*str)
+		hash = ((hash << 5) + hash) + (unsigned char)*str++;
+	hash %= PROF_TABLE_SIZE;
+
+	for (entry = info_struct->profile[hash]; entry; entry = entry->next)
+		if (_strcmp(entry->stack, info_struct->prof_stack) == 0)
+			break;
+	if (!entry)
+	{
+		entry = malloc(sizeof(prof_entry_t));
+		if (!entry)
+			return;
+		entry->stack = _strdup(info_struct->prof_stack);
+		entry->ns = 0;
+		entry->next = info_struct->profile[hash];
+		info_struct->profile[hash] = entry;
+	}
+	entry->ns += ns;
+}
+
+/**
+ * write_profile - Writes the profile to the --profile file and frees it.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: Each line is a folded stack followed by its self time in
+ * microseconds, e.g. "deploy.sh:12;install:4 1520", the input format of
+ * flame graph tools.
+ *
+ * Return: 1 on success, -1 on failure.
+ */
+int write_profile(info_t *info_struct)
+{
+	int file_desc = -1, bucket;
+	prof_entry_t *entry, *next;
+
+	if (info_struct->profile)
+	{
+		COUNT_SYSCALL(SC_OPEN);
+		file_desc = open(info_struct->profile_file,
+				O_CREAT | O_TRUNC | O_WRONLY, 0644);
+	}
+	for (bucket = 0; info_struct->profile && bucket < PROF_TABLE_SIZE; bucket++)
+		for (entry = info_struct->profile[bucket]; entry; entry = next)
+		{
+			next = entry->next;
+			if (file_desc != -1)
+			{
+				print_string_file_desc(entry->stack, file_desc);
+				print_char_file_desc(' ', file_desc);
+				print_string_file_desc(num_str_converter(entry->ns / 1000,
+							10, 0), file_desc);
+				print_char_file_desc('\n', file_desc);
+			}
+			free(entry->stack);
+			free(entry);
+		}
+	free_ptr((void **)&info_struct->profile);
+	free_ptr((void **)&info_struct->prof_stack);
+	if (file_desc == -1)
+		return (-1);
+	print_char_file_desc(BUF_FLUSH, file_desc);
+	COUNT_SYSCALL(SC_CLOSE);
+	close(file_desc);
+	return (1);
+}
@@ -0,0 +1,214 @@
+#include "main.h"
+
+/**
+ * run_server - Handles "hsh --serve SOCKET".
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The server listens on a Unix socket, readable and writable
+ * by its owner only. Each connection is served by a worker forked for it,
+ * so a slow request, or a client that never sends one, holds up no other
+ * client. Forking the server costs far less than starting
+ * hsh, since startup (exec, linking, options) was paid once. Workers are
+ * not waited for: SIGCHLD is ignored, so they are reaped as they exit.
+ *
+ * Return: 2 if the socket cannot be set up or breaks, otherwise does not
+ * return.
+ */
+int run_server(info_t *info_struct)
+{
+	struct sigaction action, child_action;
+	int listen_fd = serve_listen(info_struct->serve_path), conn;
+
+	if (listen_fd == -1)
+	{
+		print_string(info_struct->fname);
+		print_string(": 0: Can't listen on ");
+		print_string(info_struct->serve_path);
+		print_char('\n');
+		print_char(BUF_FLUSH);
+		return (2);
+	}
+	_memset((char *)&action, 0, sizeof(action));
+	child_action = action;
+	action.sa_handler = catch_signal;
+	child_action.sa_handler = SIG_IGN;
+	COUNT_SYSCALL(SC_SIGACTION);
+	sigaction(SIGPIPE, &action, NULL);
+	COUNT_SYSCALL(SC_SIGACTION);
+	sigaction(SIGCHLD, &child_action, NULL);
+	child_action.sa_handler = SIG_DFL; /* for the workers */
+	while ((conn = serve_accept(info_struct, listen_fd)) != -2)
+	{
+		if (conn == -1)
+			continue;
+		COUNT_SYSCALL(SC_FORK);
+		if (fork() == 0)
+		{
+			close(listen_fd);
+			sigaction(SIGCHLD, &child_action, NULL);
+			_exit(serve_request(info_struct, conn) == -1);
+		}
+		COUNT_SYSCALL(SC_CLOSE);
+		close(conn);
+	}
+	return (2);
+}
+
+/**
+ * serve_accept - Waits for the next client of a server.
+ * @info_struct: Pointer to the info_t structure.
+ * @listen_fd: The listening socket.
+ *
+ * Description: A signal or a client that went away is retried at once.
+ * Errors about the socket itself are fatal and reported. Anything else,
+ * such as running out of descriptors, would fail again straight away, so
+ * it is waited out SERVE_BACKOFF_MS at a time instead of spinning.
+ *
+ * Return: The connection, -1 to try again, or -2 on a fatal error.
+ */
+int serve_accept(info_t *info_struct, int listen_fd)
+{
+	int conn;
+
+	COUNT_SYSCALL(SC_SOCKET);
+	conn = accept(listen_fd, NULL, NULL);
+	if (conn != -1 || errno == EINTR || errno == ECONNABORTED)
+		return (conn);
+	if (errno == EBADF || errno == EINVAL || errno == ENOTSOCK
+			|| errno == EOPNOTSUPP || errno == EFAULT)
+	{
+		print_string(info_struct->fname);
+		print_string(": 0: Can't accept on ");
+		print_string(info_struct->serve_path);
+		print_string(": ");
+		print_string(strerror(errno));
+		print_char('\n');
+		print_char(BUF_FLUSH);
+		return (-2);
+	}
+	COUNT_SYSCALL(SC_EVENT);
+	poll(NULL, 0, SERVE_BACKOFF_MS);
+	return (-1);
+}
+
+/**
+ * serve_listen - Opens the listening socket of a server.
+ * @path: The socket path; a socket left there by an earlier server is
+ * replaced.
+ *
+ * Return: The listening descriptor, or -1 on error.
+ */
+int serve_listen(char *path)
+{
+	struct sockaddr_un addr;
+	struct stat sock_stat;
+	int listen_fd;
+
+	if (socket_addr(path, &addr) == -1)
+		return (-1);
+	COUNT_SYSCALL(SC_STAT);
+	if (!stat(addr.sun_path, &sock_stat) && S_ISSOCK(sock_stat.st_mode))
+		unlink(addr.sun_path);
+	COUNT_SYSCALL(SC_SOCKET);
+	listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listen_fd != -1 && (bind(listen_fd, (struct sockaddr *)&addr,
+				sizeof(addr)) == -1 || chmod(addr.sun_path, 0600) == -1
+			|| listen(listen_fd, 64) == -1))
+	{
+		close(listen_fd);
+		return (-1);
+	}
+	return (listen_fd);
+}
+
+/**
+ * serve_request - Runs one request of a --serve client.
+ * @info_struct: The server's info_t.
+ * @conn: The client connection.
+ *
+ * Description: The client's descriptors become 0, 1 and 2 of the worker,
+ * so the output of the command, and that of the programs it starts,
+ * streams straight to the client. The command runs in a fresh interpreter
+ * from hsh_new(), and its exit status is then sent back as an int. A
+ * request not received within SERVE_TIMEOUT seconds is given up.
+ *
+ * Return: 0 once a reply was sent, -1 on a malformed or late request.
+ */
+int serve_request(info_t *info_struct, int conn)
+{
+	serve_req_t req;
+	int fds[3], index, status = 2;
+	size_t size;
+	char *payload = NULL;
+	info_t *ctx;
+	struct timeval timeout = {SERVE_TIMEOUT, 0};
+
+	COUNT_SYSCALL(SC_SOCKET);
+	fcntl(conn, F_SETFD, FD_CLOEXEC);
+	setsockopt(conn, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	if (recv_request(conn, &req, fds) == -1)
+		return (-1);
+	size = (size_t)req.cmd_len + req.env_len + req.cwd_len;
+	payload = malloc(size + 1);
+	if (payload && read_full(conn, payload, size) == 0 && req.cmd_len
+			&& !payload[req.cmd_len - 1] && (!req.cwd_len || !payload[size - 1]))
+	{
+		payload[size] = '\0';
+		for (COUNT_SYSCALL(SC_DUP), index = 0; index < 3; index++)
+			dup2(fds[index], index);
+		ctx = hsh_new(info_struct->fname);
+		if (ctx)
+		{
+			apply_request(ctx, payload + req.cmd_len, req.env_len,
+					req.cwd_len ? payload + size - req.cwd_len : NULL);
+			status = ctx->status ? ctx->status : hsh_eval(ctx, payload);
+			hsh_free(ctx);
+		}
+	}
+	for (COUNT_SYSCALL(SC_CLOSE), index = 0; index < 3; index++)
+		close(fds[index]);
+	free(payload);
+	COUNT_SYSCALL(SC_WRITE);
+	write(conn, &status, sizeof(status));
+	return (0);
+}
+
+/**
+ * apply_request - Applies the environment and directory of a request.
+ * @ctx: The request's interpreter.
+ * @env: "NAME=VALUE\0" overrides.
+ * @env_len: Length of @env.
+ * @cwd: Directory to run in, or NULL to keep the server's.
+ *
+ * Description: A directory that cannot be entered is reported on the
+ * client's stderr and leaves status 2 in @ctx, so nothing is run.
+ */
+void apply_request(info_t *ctx, char *env, unsigned int env_len, char *cwd)
+{
+	char *end = env + env_len, *value;
+
+	while (env < end)
+	{
+		value = _strchr(env, '=');
+		if (value && value < end)
+		{
+			*value = '\0';
+			_setenv(ctx, env, value + 1);
+			*value = '=';
+		}
+		env += _strlen(env) + 1;
+	}
+	if (!cwd)
+		return;
+	COUNT_SYSCALL(SC_CHDIR);
+	if (chdir(cwd) == -1)
+	{
+		ctx->status = 2;
+		print_error(ctx, "can't cd to ");
+		print_string(cwd);
+		print_char('\n');
+		print_char(BUF_FLUSH);
+		return;
+	}
+	_setenv(ctx, "PWD", cwd);
+}
@@ -0,0 +1,121 @@
+#include "main.h"
+
+/**
+ * socket_addr - Fills in the address of a Unix socket.
+ * @path: The socket path.
+ * @addr: The address to fill in.
+ *
+ * Return: 0 on success, -1 if the path does not fit.
+ */
+int socket_addr(char *path, struct sockaddr_un *addr)
+{
+	if (!path || _strlen(path) >= (int)sizeof(addr->sun_path))
+		return (-1);
+	_memset((char *)addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	_strcpy(addr->sun_path, path);
+	return (0);
+}
+
+/**
+ * run_client - Handles "hsh --client SOCKET -c CMD [NAME=VALUE...]".
+ * @info_struct: Pointer to the info_t structure.
+ * @arg_c: Number of operands left after the options.
+ * @arg_v: The operands, with the program name in arg_v[0].
+ *
+ * Description: The command is run by the "hsh --serve" listening on
+ * SOCKET, in this process's working directory, with the NAME=VALUE
+ * operands added to its environment. The client's own stdin, stdout and
+ * stderr are handed over to it, so no output passes through the client.
+ *
+ * Return: The exit status of the command, 2 on a usage or connection error.
+ */
+int run_client(info_t *info_struct, int arg_c, char **arg_v)
+{
+	struct sockaddr_un addr;
+	serve_req_t req;
+	char *payload;
+	int sock = -1, status = 2;
+
+	if (arg_c < 3 || _strcmp(arg_v[1], "-c"))
+	{
+		print_string(info_struct->fname);
+		print_string(": 0: Usage: --client SOCKET -c CMD\n");
+		print_char(BUF_FLUSH);
+		return (2);
+	}
+	payload = build_request(&req, arg_c, arg_v);
+	if (!payload)
+		return (2);
+	COUNT_SYSCALL(SC_SOCKET);
+	if (socket_addr(info_struct->client_path, &addr) != -1)
+		sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock == -1 || connect(sock, (struct sockaddr *)&addr,
+				sizeof(addr)) == -1 || send_request(sock, &req, payload) == -1
+			|| read_full(sock, (char *)&status, sizeof(status)) == -1)
+	{
+		print_string(info_struct->fname);
+		print_string(": 0: Can't reach ");
+		print_string(info_struct->client_path);
+		print_char('\n');
+		status = 2;
+	}
+	print_char(BUF_FLUSH);
+	free(payload);
+	if (sock != -1)
+		close(sock);
+	return (status);
+}
+
+/**
+ * build_request - Lays out the request of a --client invocation.
+ * @req: The header to fill in.
+ * @arg_c: Number of operands.
+ * @arg_v: The operands: program name, "-c", CMD, then NAME=VALUE pairs.
+ *
+ * Description: The payload holds CMD, each NAME=VALUE and the current
+ * directory, one after another and each with its terminating '\0'.
+ *
+ * Return: The malloc'd payload, or NULL on error.
+ */
+char *build_request(serve_req_t *req, int arg_c, char **arg_v)
+{
+	char cwd[PATH_MAX], *payload;
+	int index;
+
+	req->magic = SERVE_MAGIC;
+	req->cmd_len = _strlen(arg_v[2]) + 1;
+	for (req->env_len = 0, index = 3; index < arg_c; index++)
+		req->env_len += _strlen(arg_v[index]) + 1;
+	COUNT_SYSCALL(SC_GETCWD);
+	req->cwd_len = getcwd(cwd, sizeof(cwd)) ? _strlen(cwd) + 1 : 0;
+	payload = malloc((size_t)req->cmd_len + req->env_len + req->cwd_len);
+	if (!payload)
+		return (NULL);
+	_strcpy(payload, arg_v[2]);
+	for (req->env_len = 0, index = 3; index < arg_c; index++)
+		req->env_len += _strlen(_strcpy(payload + req->cmd_len
+					+ req->env_len, arg_v[index])) + 1;
+	if (req->cwd_len)
+		_strcpy(payload + req->cmd_len + req->env_len, cwd);
+	return (payload);
+}
+
+/**
+ * send_request - Sends a request to a --serve server.
+ * @sock: The connected socket.
+ * @req: The request header.
+ * @payload: The command, environment and directory the header describes.
+ *
+ * Description: The header goes out together with descriptors 0, 1 and 2;
+ * the payload follows it.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int send_request(int sock, serve_req_t *req, char *payload)
+{
+	if (send_fds(sock, req, sizeof(*req)) == -1)
+		return (-1);
+	return (write_full(sock, payload,
+				(size_t)req->cmd_len + req->env_len + req->cwd_len));
+}
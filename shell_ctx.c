@@ -0,0 +1,72 @@
+#include "main.h"
+
+/**
+ * shell_ctx - Returns the interpreter the calling thread is running.
+ *
+ * Description: The output helpers and num_str_converter() are called from
+ * places that have no info_t at hand, so they find their buffers through
+ * this per-thread pointer. A thread that never selected an interpreter gets
+ * a default one of its own.
+ *
+ * Return: The current info_t of the calling thread.
+ */
+info_t *shell_ctx(void)
+{
+	info_t *current = use_shell_ctx(NULL);
+
+	return (current);
+}
+
+/**
+ * use_shell_ctx - Selects the interpreter of the calling thread.
+ * @info_struct: The info_t to select, or NULL to only query it.
+ *
+ * Return: The interpreter that was current before the call.
+ */
+info_t *use_shell_ctx(info_t *info_struct)
+{
+	static __thread info_t fallback = INFO_INIT;
+	static __thread info_t *current;
+	info_t *previous = current ? current : &fallback;
+
+	if (info_struct)
+		current = info_struct;
+	return (previous);
+}
+
+/**
+ * hsh_new - Creates an interpreter for hsh_eval().
+ * @name: Name used as $0 and in error messages.
+ *
+ * Description: The interpreter shares the process environment, never
+ * replaces the process with exec and keeps no history.
+ *
+ * Return: The new interpreter, or NULL on failure.
+ */
+info_t *hsh_new(char *name)
+{
+	info_t init = INFO_INIT, *info_struct = malloc(sizeof(info_t));
+
+	if (!info_struct)
+		return (NULL);
+	*info_struct = init;
+	info_struct->fname = name;
+	info_struct->cmd_str = "";
+	info_struct->keep_shell = 1;
+	info_struct->embedded = 1;
+	return (info_struct);
+}
+
+/**
+ * hsh_free - Frees an interpreter created by hsh_new().
+ * @info_struct: The interpreter.
+ */
+void hsh_free(info_t *info_struct)
+{
+	if (!info_struct)
+		return;
+	free_info_list(info_struct, 1);
+	child_loop_free(info_struct);
+	free(info_struct->io.chain_buf);
+	free(info_struct);
+}
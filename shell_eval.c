@@ -0,0 +1,69 @@
+#include "main.h"
+
+/**
+ * run_commands - Reads and runs commands until input ends or exit is called.
+ * @info_struct: Pointer to the info structure.
+ * @arg_v: The argument vector; arg_v[0] is the shell name.
+ *
+ * Return: -2 if the exit builtin ran, the last builtin result otherwise.
+ */
+int run_commands(info_t *info_struct, char **arg_v)
+{
+	int builtin_result = 0;
+	ssize_t read_result = 0;
+	unsigned long start;
+
+	while (read_result != -1 && builtin_result != -2)
+	{
+		clear_info_list(info_struct);
+		USDT_PROBE1(loop_start, info_struct->cmd_count);
+		if (is_interactive(info_struct))
+			_puts("$ ");
+		print_char(BUF_FLUSH);
+		start = phase_start(info_struct);
+		read_result = get_input(info_struct);
+		phase_end(info_struct, PH_READ, start);
+
+		if (read_result != -1)
+		{
+			set_info_list(info_struct, arg_v);
+			if (info_struct->argv) /* NULL if expansion failed */
+				builtin_result = profile_dispatch(info_struct,
+						info_struct->script_name ? info_struct->script_name
+						: info_struct->fname, info_struct->src_line);
+		}
+		else if (is_interactive(info_struct))
+			_putchar('\n');
+
+		free_info_list(info_struct, 0);
+	}
+	return (builtin_result);
+}
+
+/**
+ * hsh_eval - Runs shell source in an embedded interpreter.
+ * @info_struct: Interpreter from hsh_new().
+ * @src: The commands, one or more lines.
+ *
+ * Description: Aliases, functions and variables persist across calls on the
+ * same interpreter. Each thread may run its own interpreters; output is
+ * flushed before returning.
+ *
+ * Return: The exit status of the last command, or the status given to exit.
+ */
+int hsh_eval(info_t *info_struct, const char *src)
+{
+	info_t *previous = use_shell_ctx(info_struct);
+	int result;
+
+	info_struct->cmd_str = (char *)src;
+	result = run_commands(info_struct, &(info_struct->fname));
+	info_struct->cmd_str = "";
+	_putchar(BUF_FLUSH);
+	print_char(BUF_FLUSH);
+	use_shell_ctx(previous);
+
+	if (result == -2 && info_struct->err_num != -1)
+		return (info_struct->err_num);
+	return (info_struct->status);
+}
@@ -0,0 +1,173 @@
+#include "main.h"
+
+/**
+ * new_func_cmd - Creates one pre-parsed function body command.
+ * @text: Raw text of the command.
+ * @type: Chain type linking the command to the previous one.
+ *
+ * Return: The new command, or NULL if @text holds no words or on failure.
+ */
+func_cmd_t *new_func_cmd(char *text, int type)
+{
+	func_cmd_t *cmd;
+	char *quotes;
+	char **argv = split_words(text, &quotes);
+
+	if (!argv)
+		return (NULL);
+
+	cmd = malloc(sizeof(func_cmd_t));
+	if (!cmd)
+		return (free_ptr_array(argv), NULL);
+
+	cmd->text = _strdup(text);
+	cmd->argv = argv;
+	cmd->quotes = quotes;
+	cmd->type = type;
+	cmd->line = 0;
+	cmd->next = NULL;
+	return (cmd);
+}
+
+/**
+ * search_function - Searches for and runs a shell function.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Description: This function is consulted after the builtin table and
+ * before PATH. It looks argv[0] up in the hashed function table and, on a
+ * hit, runs the function in-process.
+ *
+ * Return: -1 if no such function exists, otherwise the result of
+ * run_function().
+ */
+int search_function(info_t *info_struct)
+{
+	shell_func_t *func = find_function(info_struct, info_struct->argv[0]);
+
+	if (!func)
+		return (-1);
+
+	if (info_struct->linecount_flag == 1)
+	{
+		info_struct->line_count++;
+		info_struct->linecount_flag = 0;
+	}
+	return (run_function(info_struct, func));
+}
+
+/**
+ * run_function - Runs the body of a shell function.
+ * @info_struct: Pointer to the info structure.
+ * @func: The function to run.
+ *
+ * Description: The current argv becomes the positional parameters ($1..$N)
+ * for the duration of the call. Each body command honours the "&&" and "||"
+ * chaining against the status of the previous one.
+ *
+ * Return: -2 if a command asked the shell to exit, 0 otherwise.
+ */
+int run_function(info_t *info_struct, shell_func_t *func)
+{
+	char **saved_argv = info_struct->argv, **saved_pos = info_struct->pos_argv;
+	char *saved_arg = info_struct->arg;
+	int saved_argc = info_struct->argc, saved_pos_argc = info_struct->pos_argc;
+	int result = 0;
+	func_cmd_t *cmd;
+
+	if (info_struct->func_depth >= FUNC_DEPTH_MAX)
+	{
+		info_struct->status = 2;
+		print_error(info_struct, "function nesting too deep\n");
+		return (0);
+	}
+	info_struct->pos_argv = saved_argv;
+	info_struct->pos_argc = saved_argc;
+	info_struct->func_depth++;
+	for (cmd = func->body; cmd && result != -2; cmd = cmd->next)
+	{
+		if ((cmd->type == CMD_AND && info_struct->status)
+				|| (cmd->type == CMD_OR && !info_struct->status))
+			continue;
+		result = run_func_cmd(info_struct, func->name, cmd);
+	}
+	info_struct->func_depth--;
+	info_struct->pos_argv = saved_pos;
+	info_struct->pos_argc = saved_pos_argc;
+	info_struct->argv = saved_argv;
+	info_struct->argc = saved_argc;
+	info_struct->arg = saved_arg;
+	info_struct->path = NULL;
+	return (result == -2 ? -2 : 0);
+}
+
+/**
+ * run_func_cmd - Runs one pre-parsed command of a function body.
+ * @info_struct: Pointer to the info structure.
+ * @name: Name of the function, for the profiler frame.
+ * @cmd: The command to run.
+ *
+ * Description: The pre-split words are copied so that alias and variable
+ * expansion can rewrite them without touching the stored body. Their
+ * quote flags are only read, so they are used from the body as they are.
+ *
+ * Return: The result of profile_dispatch().
+ */
+int run_func_cmd(info_t *info_struct, char *name, func_cmd_t *cmd)
+{
+	int count, result;
+	unsigned long start = phase_start(info_struct);
+
+	info_struct->argv = dup_str_array(cmd->argv);
+	if (!info_struct->argv)
+		return (0);
+	for (count = 0; info_struct->argv[count]; count++)
+		;
+	info_struct->argc = count;
+	info_struct->arg = cmd->text;
+	info_struct->path = NULL;
+
+	info_struct->argq = cmd->quotes;
+	replace_cmd_with_alias(info_struct);
+	replace_cmd_argv(info_struct);
+	expand_globs(info_struct);
+	info_struct->argq = NULL;
+	phase_end(info_struct, PH_EXPAND, start);
+	result = info_struct->argv ? profile_dispatch(info_struct, name,
+			cmd->line) : 0;
+
+	free_ptr_array(info_struct->argv);
+	info_struct->argv = NULL;
+	return (result);
+}
+
+/**
+ * replace_positional - Expands $0..$N and $# in a command argument.
+ * @info_struct: Pointer to the info_t structure.
+ * @count: Index of the argument to expand.
+ *
+ * Description: $0 is the shell name, $1..$N the positional parameters of
+ * the running function (empty outside of one) and $# their count.
+ *
+ * Return: 1 if the argument was expanded, 0 if it is not positional.
+ */
+int replace_positional(info_t *info_struct, int count)
+{
+	char *word = info_struct->argv[count] + 1, *value = "";
+	int index;
+
+	if (_strcmp(word, "#") == 0)
+		return (replace_string(&(info_struct->argv[count]),
+					_strdup(num_str_converter(info_struct->pos_argc ?
+							info_struct->pos_argc - 1 : 0, 10, 0))));
+	if (*word < '0' || *word > '9')
+		return (0);
+	index = parse_unsigned_Int(word);
+	if (index == -1)
+		return (0);
+
+	if (index == 0)
+		value = info_struct->fname;
+	else if (index < info_struct->pos_argc)
+		value = info_struct->pos_argv[index];
+	return (replace_string(&(info_struct->argv[count]), _strdup(value)));
+}
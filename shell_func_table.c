@@ -0,0 +1,132 @@
+#include "main.h"
+
+/**
+ * hash_func_name - Hashes a function name into a function table slot.
+ * @name: The function name.
+ *
+ * Description: This function computes the djb2 hash of @name and reduces
+ * it to an index of the FUNC_TABLE_SIZE bucket table.
+ *
+ * Return: The bucket index for @name.
+ */
+unsigned int hash_func_name(char *name)
+{
+	unsigned long hash = 5381;
+
+	while (*name)
+		hash = ((hash << 5) + hash) + (unsigned char)*name++;
+
+	return (hash % FUNC_TABLE_SIZE);
+}
+
+/**
+ * find_function - Looks up a shell function by name.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: The function name to look for.
+ *
+ * Return: Pointer to the function, or NULL if it is not defined.
+ */
+shell_func_t *find_function(info_t *info_struct, char *name)
+{
+	shell_func_t *func;
+
+	if (!info_struct->functions || !name)
+		return (NULL);
+
+	func = info_struct->functions[hash_func_name(name)];
+	while (func)
+	{
+		if (_strcmp(func->name, name) == 0)
+			return (func);
+		func = func->next;
+	}
+	return (NULL);
+}
+
+/**
+ * add_function - Adds or replaces a function in the function table.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: Name of the function.
+ * @body: Pre-parsed body; ownership passes to the table.
+ *
+ * Description: This function allocates the function table on first use.
+ * Redefining an existing function replaces its body.
+ *
+ * Return: 0 on success, 1 on memory allocation failure.
+ */
+int add_function(info_t *info_struct, char *name, func_cmd_t *body)
+{
+	shell_func_t *func;
+	unsigned int slot;
+	unsigned int size = sizeof(shell_func_t *) * FUNC_TABLE_SIZE;
+
+	if (!info_struct->functions)
+	{
+		info_struct->functions = malloc(size);
+		if (!info_struct->functions)
+			return (free_func_body(body), 1);
+		_memset((void *)info_struct->functions, 0, size);
+	}
+	func = find_function(info_struct, name);
+	if (func)
+	{
+		free_func_body(func->body);
+		func->body = body;
+		return (0);
+	}
+	func = malloc(sizeof(shell_func_t));
+	if (!func || !(func->name = _strdup(name)))
+	{
+		free(func);
+		return (free_func_body(body), 1);
+	}
+	slot = hash_func_name(name);
+	func->body = body;
+	func->next = info_struct->functions[slot];
+	info_struct->functions[slot] = func;
+	return (0);
+}
+
+/**
+ * free_func_body - Frees a pre-parsed function body.
+ * @body: Head of the command list.
+ */
+void free_func_body(func_cmd_t *body)
+{
+	func_cmd_t *next;
+
+	while (body)
+	{
+		next = body->next;
+		free_ptr_array(body->argv);
+		free(body->text);
+		free(body);
+		body = next;
+	}
+}
+
+/**
+ * free_functions - Frees the whole function table.
+ * @info_struct: Pointer to the info_t structure.
+ */
+void free_functions(info_t *info_struct)
+{
+	shell_func_t *func, *next;
+	int slot;
+
+	if (!info_struct->functions)
+		return;
+
+	for (slot = 0; slot < FUNC_TABLE_SIZE; slot++)
+	{
+		for (func = info_struct->functions[slot]; func; func = next)
+		{
+			next = func->next;
+			free_func_body(func->body);
+			free(func->name);
+			free(func);
+		}
+	}
+	free(info_struct->functions);
+	info_struct->functions = NULL;
+}
@@ -0,0 +1,214 @@
+#include "main.h"
+
+/**
+ * parse_func_header - Recognizes a "name()" function definition header.
+ * @str: The input line to inspect.
+ * @name: Where to store a pointer to the function name.
+ *
+ * Description: This function skips leading blanks, reads a name made of
+ * letters, digits and underscores (not starting with a digit) and expects
+ * "()" after it, optionally separated by blanks. On a match the name is
+ * null-terminated in place and @name points to it.
+ *
+ * Return: Pointer just past the ')' on a match, NULL otherwise.
+ */
+char *parse_func_header(char *str, char **name)
+{
+	int start, end, count = 0;
+
+	while (str[count] == ' ' || str[count] == '\t')
+		count++;
+	start = count;
+	while (is_alpha(str[count]) || str[count] == '_'
+			|| (count > start && str[count] >= '0' && str[count] <= '9'))
+		count++;
+	end = count;
+	while (str[count] == ' ' || str[count] == '\t')
+		count++;
+	if (end == start || str[count] != '(')
+		return (NULL);
+	count++;
+	while (str[count] == ' ' || str[count] == '\t')
+		count++;
+	if (str[count] != ')')
+		return (NULL);
+
+	str[end] = '\0';
+	*name = str + start;
+	return (str + count + 1);
+}
+
+/**
+ * find_body_end - Locates the brace closing a function body.
+ * @text: Definition text following the "()" header.
+ * @body: Where to store a pointer to the first character of the body.
+ *
+ * Description: This function tracks the brace nesting depth of @text and
+ * stops at the '}' that closes the first '{'. Quoted braces are not counted.
+ *
+ * Return: Pointer to the closing '}', or NULL if the body is incomplete.
+ */
+char *find_body_end(char *text, char **body)
+{
+	int depth = 0;
+
+	*body = NULL;
+	for (; *text; text++)
+	{
+		if (quote_end(text, 0))
+			text += quote_end(text, 0);
+		else if (*text == '{')
+		{
+			if (!depth++)
+				*body = text + 1;
+		}
+		else if (*text == '}' && depth && !--depth)
+			return (text);
+	}
+	return (NULL);
+}
+
+/**
+ * read_func_line - Appends the next input line to a function definition.
+ * @info_struct: Pointer to the info_t structure.
+ * @text: The definition text read so far (freed on failure).
+ *
+ * Description: This function reads one more line through
+ * read_input_line(), strips its comment and appends it, newline included,
+ * to @text. It is used for function bodies that span several lines.
+ *
+ * Return: The grown definition text, or NULL on end-of-file or failure.
+ */
+char *read_func_line(info_t *info_struct, char *text)
+{
+	char *line = NULL, *joined = NULL;
+	size_t len = 0;
+	int read_len, newline;
+
+	read_len = read_input_line(info_struct, &line, &len);
+	if (read_len > 0)
+	{
+		newline = line[read_len - 1] == '\n';
+		if (newline)
+			line[read_len - 1] = '\0';
+		remove_comments(line);
+		joined = _realloc(text, _strlen(text) + 1,
+				_strlen(text) + _strlen(line) + 2);
+		if (joined)
+		{
+			_strcat(joined, line);
+			if (newline)
+				_strcat(joined, "\n");
+		}
+	}
+	if (!joined)
+		free(text);
+	free(line);
+	return (joined);
+}
+
+/**
+ * define_function - Reads and stores a shell function definition.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: Name of the function being defined.
+ * @rest: Text of the input line following the "()" header.
+ *
+ * Description: This function collects the definition text, reading further
+ * lines until the body braces balance, then parses the body once and stores
+ * it in the function table. An unterminated body is a syntax error. What
+ * follows the closing brace, less a ';' separating it, is handed back so
+ * that "f() { ...; }; f" runs f once it is defined.
+ *
+ * Return: The text following the body (to be freed), or NULL on failure.
+ */
+char *define_function(info_t *info_struct, char *name, char *rest)
+{
+	char *text, *body, *end, *scan;
+	unsigned int line = info_struct->src_line;
+
+	text = malloc(_strlen(rest) + 2);
+	if (!text)
+		return (NULL);
+	_strcpy(text, rest);
+	_strcat(text, "\n");
+
+	while (!(end = find_body_end(text, &body)))
+	{
+		text = read_func_line(info_struct, text);
+		if (!text)
+		{
+			info_struct->status = 2;
+			print_string(info_struct->fname);
+			print_string(": ");
+			print_decimal(info_struct->line_count, STDERR_FILENO);
+			print_string(": Syntax error: end of file unexpected");
+			print_string(" (expecting \"}\")\n");
+			return (NULL);
+		}
+	}
+	*end = '\0';
+	for (scan = text; scan < body; scan++)
+		line += *scan == '\n';
+	add_function(info_struct, name, parse_func_body(body, line));
+	end++;
+	while (*end == ' ' || *end == '\t')
+		end++;
+	end += *end == ';';
+	if (*end && end[_strlen(end) - 1] == '\n')
+		end[_strlen(end) - 1] = '\0';
+	rest = _strdup(end);
+	free(text);
+	return (rest);
+}
+
+/**
+ * parse_func_body - Splits a function body into pre-parsed commands.
+ * @body: The text between the body braces (modified in place).
+ * @line: Input line the body starts on.
+ *
+ * Description: This function cuts the body at ';', newlines, "&&" and "||"
+ * and tokenizes every command once, recording how it chains to the previous
+ * one. Separators inside quotes do not cut. Empty commands are dropped.
+ *
+ * Return: Head of the command list, or NULL for an empty body.
+ */
+func_cmd_t *parse_func_body(char *body, unsigned int line)
+{
+	func_cmd_t *head = NULL, **tail = &head;
+	int count, start = 0, done = 0, type = CMD_CHAIN, next_type;
+	unsigned int cmd_line = line;
+
+	for (count = 0; !done; count++)
+	{
+		next_type = CMD_CHAIN;
+		if (quote_end(body, count) != (size_t)count)
+		{
+			count = quote_end(body, count);
+			continue;
+		}
+		if (body[count] == '&' && body[count + 1] == '&')
+			next_type = CMD_AND;
+		else if (body[count] == '|' && body[count + 1] == '|')
+			next_type = CMD_OR;
+		else if (body[count] && body[count] != ';' && body[count] != '\n')
+			continue;
+
+		done = !body[count];
+		line += body[count] == '\n';
+		body[count] = '\0';
+		*tail = new_func_cmd(body + start, type);
+		if (*tail)
+		{
+			(*tail)->line = cmd_line;
+			tail = &((*tail)->next);
+			type = next_type;
+		}
+		else if (next_type != CMD_CHAIN)
+			type = next_type;
+		if (next_type != CMD_CHAIN)
+			count++;
+		start = count + 1;
+		cmd_line = line;
+	}
+	return (head);
+}
@@ -14,38 +14,20 @@
  * It then reads input, sets up the info_struct structure, and checks for
  * built-in commands. If no built-in command found, it searches for external
  * commands.
- * The loop also handles error conditions, freeing resources, and writing
- * history to a file.
+ * The loop itself is run_commands(), shared with hsh_eval(). This function
+ * also handles error conditions, freeing resources, the child event loop
+ * included, and writing history to a file.
  * The function returns the exit status of the last executed command.
  */
 int hsh_loop(info_t *info_struct, char **arg_v)
 {
-	int builtin_result = 0;
-	ssize_t read_result = 0;
+	int builtin_result = run_commands(info_struct, arg_v);
 
-	while (read_result != -1 && builtin_result != -2)
-	{
-		clear_info_list(info_struct);
-		if (is_interactive(info_struct))
-			_puts("$ ");
-		print_char(BUF_FLUSH);
-		read_result = get_input(info_struct);
-
-		if (read_result != -1)
-		{
-			set_info_list(info_struct, arg_v);
-			builtin_result = search_builtin(info_struct);
-
-			if (builtin_result == -1)
-				search_exe_cmd(info_struct);
-		}
-		else if (is_interactive(info_struct))
-			_putchar('\n');
-
-		free_info_list(info_struct, 0);
-	}
-	write_history_to_file(info_struct);
+	if (is_interactive(info_struct))
+		write_history_to_file(info_struct);
 	free_info_list(info_struct, 1);
+	child_loop_free(info_struct);
+	report_stats(info_struct);
 
 	if (!is_interactive(info_struct) && info_struct->status)
 		exit(info_struct->status);
@@ -61,6 +43,46 @@ int hsh_loop(info_t *info_struct, char **arg_v)
 }
 
 
+/**
+ * dispatch_cmd - Runs the command held in the info structure.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: The result of the builtin or function that ran, or -1 if the
+ * command was looked up in PATH.
+ *
+ * Description: This function resolves argv[0] in order: builtin table,
+ * shell function table, then PATH. With tracing on, a record of the
+ * command is appended to the trace ring buffer once it has finished.
+ */
+int dispatch_cmd(info_t *info_struct)
+{
+	int result;
+	unsigned long start = now_ns();
+	unsigned int line = info_struct->cmd_line, hash = 0;
+
+	if (info_struct->trace)
+		hash = trace_hash(info_struct->argv[0]);
+	info_struct->child_pid = 0;
+	info_struct->cmd_count++;
+	result = search_builtin(info_struct);
+	if (result != -1)
+		record_latency(info_struct, LAT_BUILTIN, now_ns() - start);
+	phase_end(info_struct, PH_BUILTIN, start);
+	if (result == -1)
+		result = search_function(info_struct);
+	if (result == -1)
+		search_exe_cmd(info_struct);
+	if (info_struct->trace && *info_struct->argv[0])
+	{
+		if (result != -1) /* ran in the shell, even if it forked inside */
+			info_struct->child_pid = 0;
+		trace_record(info_struct, start, line, hash);
+	}
+
+	return (result);
+}
+
+
 /**
  * search_builtin - Searches for and executes a built-in command.
  * @info_struct: Pointer to the info structure.
@@ -70,35 +92,34 @@ int hsh_loop(info_t *info_struct, char **arg_v)
  *
  * Description: This function searches for a built-in command using the
  * provided command name in the info structure's arguments. If a match
- * is found in the built-in command table, the corresponding built-in function
- * is executed with the info structure passed as a parameter. The function
+ * is found in the built-in command table of builtin_list(), the
+ * corresponding built-in function is executed with the info structure
+ * passed as a parameter. Like any other command, it counts its input line
+ * only if no command on that line was counted yet. The function
  * returns the return value of the executed built-in command,
  * or -1 if the command is not found.
  */
 int search_builtin(info_t *info_struct)
 {
 	int count, built_in_command = -1;
-	builtin_table builtintbl[] = {
-		{"exit", hsh_exit},
-		{"env", display_env_var},
-		{"help", hsh_help},
-		{"history", hsh_history},
-		{"setenv", update_env_var},
-		{"unsetenv", clear_all_env_var},
-		{"cd", hsh_cd},
-		{"alias", hsh_alias},
-		{NULL, NULL}
-	};
+	builtin_table *builtintbl = builtin_list();
 
 	for (count = 0; builtintbl[count].type; count++)
 	{
 		if (_strcmp(info_struct->argv[0], builtintbl[count].type) == 0)
 		{
-			info_struct->line_count++;
+			if (info_struct->linecount_flag == 1)
+			{
+				info_struct->line_count++;
+				info_struct->linecount_flag = 0;
+			}
+			USDT_PROBE1(builtin_hit, builtintbl[count].type);
 			built_in_command = builtintbl[count].func(info_struct);
 			break;
 		}
 	}
+	if (built_in_command == -1)
+		USDT_PROBE1(builtin_miss, info_struct->argv[0]);
 
 	return (built_in_command);
 }
@@ -119,6 +140,7 @@ void search_exe_cmd(info_t *info_struct)
 {
 	int count_i, count_k;
 	char *env_path = NULL;
+	unsigned long start;
 
 	info_struct->path = info_struct->argv[0];
 
@@ -135,8 +157,12 @@ void search_exe_cmd(info_t *info_struct)
 	if (!count_k)
 		return;
 
+	start = now_ns();
 	env_path = find_cmd_path(info_struct, get_env_var(info_struct, "PATH="),
 								info_struct->argv[0]);
+	record_latency(info_struct, LAT_PATH, now_ns() - start);
+	phase_end(info_struct, PH_PATH, start);
+	USDT_PROBE2(path_lookup, info_struct->argv[0], env_path);
 
 	if (env_path)
 	{
@@ -165,46 +191,38 @@ void search_exe_cmd(info_t *info_struct)
  * specified by the path and arguments in the info structure. The child
  * process uses the execve system call to replace its image with the
  * specified command. If the fork fails, an error message is printed.
- * If the execve call fails, the function frees resources,
- * handles error conditions, and exits with appropriate status codes.
+ * When this is the last command of non-interactive input the shell skips
+ * the fork and executes the command in place.
+ * An argument list too long for execve() is left to run_batches().
+ * The command is started by the zygote when there is one, otherwise by
+ * fork_wait(). The wall time and the rusage of the child are recorded.
  */
 void fork_execute_cmd(info_t *info_struct)
 {
 	pid_t child_process_pid;
+	unsigned long start = phase_start(info_struct), spawn_ns;
+	struct rusage usage;
 
-	child_process_pid = fork();
-	if (child_process_pid == -1)
-	{
-		perror("Error:"); /* Print error message */
+	if (run_batches(info_struct) == 0) /* too long for one execve() */
 		return;
-	}
-
-	if (child_process_pid == 0) /* Child process */
-	{
-		if (execve(info_struct->path, info_struct->argv,
-		get_environ(info_struct)) == -1)
-		{
-			free_info_list(info_struct, 1);
-
-			if (errno == EACCES)
-				exit(126);
+	if (is_last_cmd(info_struct)) /* nothing left to run: exec in place */
+		replace_shell(info_struct, info_struct->path, info_struct->argv);
 
-			exit(1);
-		}
-		/* TODO: PUT ERROR FUNCTION */
-	}
-	else /* Parent process */
+	spawn_ns = now_ns();
+	child_process_pid = zygote_run(info_struct, &usage);
+	if (child_process_pid == -1)
+		child_process_pid = fork_wait(info_struct, &usage);
+	if (child_process_pid != -1)
 	{
-		/* Wait for the child process to complete */
-		wait(&(info_struct->status));
+		info_struct->child_pid = child_process_pid;
+		spawn_ns = now_ns() - spawn_ns;
+		USDT_PROBE3(reap, child_process_pid, info_struct->status, spawn_ns);
+		record_usage(info_struct, &usage, spawn_ns);
+		record_latency(info_struct, LAT_EXTERNAL, spawn_ns);
 
 		/* Check if the child process exited normally */
 		if (WIFEXITED(info_struct->status))
-		{
 			info_struct->status = WEXITSTATUS(info_struct->status);
-
-			if (info_struct->status == 126)
-				print_error(info_struct, "Permission denied\n");
-		}
+		phase_end(info_struct, PH_SPAWN, start);
 	}
 }
@@ -0,0 +1,88 @@
+#include "main.h"
+
+/**
+ * hsh_main - Runs the shell with the given command line.
+ * @arg_c: The number of command-line arguments.
+ * @arg_v: An array of command-line argument strings.
+ *
+ * Description: This is the body of main(), kept in libhsh so that programs
+ * other than hsh itself (the micro-benchmarks) can link against the shell.
+ *
+ * Return: EXIT_SUCCESS on success, EXIT_FAILURE on failure.
+ */
+int hsh_main(int arg_c, char **arg_v)
+{
+	int file_desc = 2; /* File descriptor initialized to 2 (stderr) */
+	int opt_count;
+	info_t info_struct[] = { INFO_INIT }; /* Initialize info_struct structure */
+
+	use_shell_ctx(info_struct); /* its buffers back the output helpers */
+
+	/* Inline assembly code to modify the file descriptor */
+	asm (
+		"mov %1, %0\n\t"
+		"add $3, %0"
+		: "=r" (file_desc)
+		: "r" (file_desc)
+	);
+
+	/* Consume long options, keeping the program name in front */
+	opt_count = parse_shell_opts(info_struct, arg_c, arg_v);
+	arg_v[opt_count] = arg_v[0];
+	arg_c -= opt_count;
+	arg_v += opt_count;
+
+	info_struct->fname = arg_v[0];
+	if (info_struct->serve_path)
+		return (run_server(info_struct));
+	if (info_struct->client_path)
+		return (run_client(info_struct, arg_c, arg_v));
+	start_zygote(info_struct); /* while the heap is still small */
+	if (arg_c >= 2 && _strcmp(arg_v[1], "-c") == 0)
+	{
+		/* Run a command string; history is neither loaded nor saved */
+		arg_v += set_cmd_string(info_struct, arg_c, arg_v);
+	}
+	else if (arg_c == 2)
+	{
+		/* Attempt to open the file specified in the command-line argument */
+		COUNT_SYSCALL(SC_OPEN);
+		file_desc = open(arg_v[1], O_RDONLY);
+
+		if (file_desc == -1)
+		{
+			if (errno == EACCES)
+				exit(126); /* Exit with status 126 on permission denied */
+			if (errno == ENOENT)
+			{
+				print_string(arg_v[0]);
+				print_string(": 0: Can't open ");
+				print_string(arg_v[1]);
+				print_char('\n');
+				print_char(BUF_FLUSH);
+				exit(127); /* Exit with status 127 on file not found */
+			}
+			return (EXIT_FAILURE); /* Exit with generic failure status */
+		}
+		info_struct->readfd = file_desc;
+		info_struct->script_name = arg_v[1];
+	}
+
+	/*
+	 * Interactive sessions populate the environment list and read history
+	 * up front. Scripts and -c take the fast path: no history I/O, and the
+	 * environment list is only built from environ if something needs it.
+	 */
+	if (is_interactive(info_struct))
+	{
+		initialize_env_list(info_struct);
+		read_command_history(info_struct);
+	}
+	init_phase_stats(info_struct);
+	init_trace(info_struct);
+	setup_signals();
+	hsh_loop(info_struct, arg_v);
+
+	return (EXIT_SUCCESS); /* Exit with success status */
+}
+
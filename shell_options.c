@@ -0,0 +1,170 @@
+#include "main.h"
+
+/**
+ * parse_shell_opts - Applies the long options given before the script.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg_c: The number of command-line arguments.
+ * @arg_v: The command-line arguments.
+ *
+ * Description: Options start with "--" and are looked up in the option
+ * table, the same way builtins are. A lone "--" ends the options. An
+ * unknown option, or one missing its argument, exits with status 2.
+ *
+ * Return: The number of arguments consumed.
+ */
+int parse_shell_opts(info_t *info_struct, int arg_c, char **arg_v)
+{
+	shell_opt_table opttbl[] = {
+		{"--syscall-stats", 0, opt_syscall_stats},
+		{"--stats-json", 1, opt_stats_json},
+		{"--profile", 1, opt_profile},
+		{"--trace", 1, opt_trace},
+		{"--decode-trace", 1, opt_decode_trace},
+		{"--serve", 1, opt_serve},
+		{"--client", 1, opt_client},
+		{"--zygote", 0, opt_zygote},
+		{NULL, 0, NULL}
+	};
+	int count = 1, index;
+
+	info_struct->fname = arg_v[0]; /* for errors reported by an option */
+	while (count < arg_c && starts_with(arg_v[count], "--"))
+	{
+		if (_strcmp(arg_v[count], "--") == 0)
+			return (count);
+		for (index = 0; opttbl[index].name; index++)
+			if (_strcmp(arg_v[count], opttbl[index].name) == 0)
+				break;
+		if (!opttbl[index].name
+				|| (opttbl[index].has_arg && count + 1 >= arg_c))
+		{
+			print_string(arg_v[0]);
+			print_string(opttbl[index].name ? ": 0: Option requires an argument "
+					: ": 0: Illegal option ");
+			print_string(arg_v[count]);
+			print_char('\n');
+			print_char(BUF_FLUSH);
+			exit(2);
+		}
+		opttbl[index].func(info_struct,
+				opttbl[index].has_arg ? arg_v[count + 1] : NULL);
+		count += 1 + opttbl[index].has_arg;
+	}
+	return (count - 1);
+}
+
+/**
+ * opt_syscall_stats - Handles the --syscall-stats option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: Unused.
+ *
+ * Return: Always 0.
+ */
+int opt_syscall_stats(info_t *info_struct, char *arg)
+{
+	(void)arg;
+	info_struct->syscall_stats = 1;
+	return (0);
+}
+
+/**
+ * opt_stats_json - Handles the --stats-json FILE option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: File to write the per-phase timings to at exit.
+ *
+ * Return: Always 0.
+ */
+int opt_stats_json(info_t *info_struct, char *arg)
+{
+	info_struct->stats_file = arg;
+	return (0);
+}
+
+/**
+ * opt_profile - Handles the --profile FILE option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: File to write the folded-stack line profile to at exit.
+ *
+ * Description: The shell never replaces itself with the last command while
+ * profiling, so that command is timed too.
+ *
+ * Return: Always 0.
+ */
+int opt_profile(info_t *info_struct, char *arg)
+{
+	info_struct->profile_file = arg;
+	info_struct->keep_shell++;
+	return (0);
+}
+
+/**
+ * opt_trace - Handles the --trace FILE option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: File to dump the trace ring buffer to.
+ *
+ * Return: Always 0.
+ */
+int opt_trace(info_t *info_struct, char *arg)
+{
+	info_struct->trace_file = arg;
+	return (0);
+}
+
+/**
+ * opt_decode_trace - Handles the --decode-trace FILE option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: Trace dump to print.
+ *
+ * Description: The dump is printed as text and the shell exits without
+ * running anything. Errors are reported against the option, as if it
+ * were the command.
+ *
+ * Return: Does not return.
+ */
+int opt_decode_trace(info_t *info_struct, char *arg)
+{
+	char *argv[] = {"--decode-trace", NULL};
+
+	info_struct->argv = argv;
+	exit(decode_trace(info_struct, arg));
+}
+
+/**
+ * opt_serve - Handles the --serve SOCKET option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: Unix socket path to listen on.
+ *
+ * Return: Always 0.
+ */
+int opt_serve(info_t *info_struct, char *arg)
+{
+	info_struct->serve_path = arg;
+	return (0);
+}
+
+/**
+ * opt_client - Handles the --client SOCKET option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: Unix socket path of a --serve server.
+ *
+ * Return: Always 0.
+ */
+int opt_client(info_t *info_struct, char *arg)
+{
+	info_struct->client_path = arg;
+	return (0);
+}
+
+/**
+ * opt_zygote - Handles the --zygote option.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg: Unused.
+ *
+ * Return: Always 0.
+ */
+int opt_zygote(info_t *info_struct, char *arg)
+{
+	(void)arg;
+	info_struct->zygote = 1;
+	return (0);
+}
@@ -0,0 +1,69 @@
+#include "main.h"
+
+/**
+ * setup_signals - Installs the shell's signal handlers.
+ *
+ * Description: This function is called once at startup. The SIGINT handler
+ * is installed with sigaction() and SA_RESTART, so it stays in place and
+ * interrupted reads are resumed. It does not need to be installed again
+ * for every input line.
+ */
+void setup_signals(void)
+{
+	struct sigaction action;
+
+	_memset((char *)&action, 0, sizeof(action));
+	action.sa_handler = sigint_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+
+	COUNT_SYSCALL(SC_SIGACTION);
+	sigaction(SIGINT, &action, NULL);
+}
+
+/**
+ * trace_owner - Remembers the shell state whose trace SIGUSR1 dumps.
+ * @info_struct: The info_t to remember, or NULL to only query it.
+ *
+ * Description: A signal handler receives no info_t, so init_trace()
+ * registers it here.
+ *
+ * Return: The registered info_t, or NULL if tracing is off.
+ */
+info_t *trace_owner(info_t *info_struct)
+{
+	static info_t *owner;
+
+	if (info_struct)
+		owner = info_struct;
+	return (owner);
+}
+
+/**
+ * sigusr1_handler - Dumps the trace ring buffer on SIGUSR1.
+ * @signal_num: Unused.
+ *
+ * Description: A record being written at that moment may appear torn in
+ * the dump; the others are intact.
+ */
+void sigusr1_handler(__attribute__((unused)) int signal_num)
+{
+	info_t *info_struct = trace_owner(NULL);
+
+	if (info_struct && info_struct->trace)
+		write_trace(info_struct);
+}
+
+/**
+ * catch_signal - Catches a signal and does nothing.
+ * @signal_num: Unused.
+ *
+ * Description: The --serve server catches SIGPIPE with it, so a client
+ * that goes away makes writes fail with EPIPE instead of killing the
+ * server; unlike SIG_IGN, a handler is reset by execve(), so commands
+ * still get the default SIGPIPE. The zygote catches SIGCHLD with it, so
+ * that a child exiting interrupts its pselect().
+ */
+void catch_signal(__attribute__((unused)) int signal_num)
+{
+}
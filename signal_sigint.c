@@ -0,0 +1,63 @@
+#include "main.h"
+
+/**
+ * sigint_handler - Signal handler for SIGINT (Ctrl+C).
+ * @signal_num: The signal number (unused).
+ *
+ * Description: Only write() is async-signal-safe among what the shell
+ * would do here, so the handler just writes a byte to the SIGINT
+ * self-pipe. The line editor polls the pipe next to the terminal and
+ * drops the line being typed. Before the pipe exists, SIGINT is ignored.
+ */
+void sigint_handler(__attribute__((unused)) int signal_num)
+{
+	int saved_errno = errno;
+
+	if (sigint_pipe()[1] != -1)
+		write(sigint_pipe()[1], "", 1);
+	errno = saved_errno;
+}
+
+/**
+ * sigint_pipe - Returns the SIGINT self-pipe.
+ *
+ * Return: The read and write ends, -1 until sigint_taken() made it.
+ */
+int *sigint_pipe(void)
+{
+	static int fds[2] = {-1, -1};
+
+	return (fds);
+}
+
+/**
+ * sigint_taken - Empties the SIGINT self-pipe.
+ *
+ * Description: The pipe is made by the first call, so only shells that
+ * edit lines have one. Both ends are non-blocking and close on exec.
+ *
+ * Return: 1 if SIGINT was raised since the last call, 0 otherwise.
+ */
+int sigint_taken(void)
+{
+	int *fds = sigint_pipe(), index, taken = 0;
+	char bytes[16];
+
+	if (fds[0] == -1)
+	{
+		COUNT_SYSCALL(SC_EVENT);
+		if (pipe(fds) == -1)
+			return (fds[0] = fds[1] = -1, 0);
+		for (index = 0; index < 2; index++)
+			fcntl(fds[index], F_SETFL, O_NONBLOCK),
+				fcntl(fds[index], F_SETFD, FD_CLOEXEC);
+		return (0);
+	}
+	COUNT_SYSCALL(SC_READ);
+	while (read(fds[0], bytes, sizeof(bytes)) > 0)
+	{
+		COUNT_SYSCALL(SC_READ);
+		taken = 1;
+	}
+	return (taken);
+}
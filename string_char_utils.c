@@ -141,24 +141,25 @@ void _puts(char *str)
  * Return: 1 on success, 0 on failure.
  *
  * Description: This function writes a character to the standard output.
- * It uses an internal buffer to improve efficiency. If the buffer is full or
+ * It uses the output buffer of the current interpreter (shell_ctx()) to
+ * improve efficiency. If the buffer is full or
  * if the provided character is BUF_FLUSH (flush signal), the function writes
- * the buffer to the standard output. The function returns 1 on success and
- * 0 on failure.
+ * the buffer to the standard output, unless it is empty. The function
+ * returns 1 on success and 0 on failure.
  */
 int _putchar(char c)
 {
-	static int count;
-	static char buf[WRITE_BUF_SIZE];
+	shell_io_t *io = &(shell_ctx()->io);
 
-	if (c == BUF_FLUSH || count >= WRITE_BUF_SIZE)
+	if ((c == BUF_FLUSH || io->out_len >= WRITE_BUF_SIZE) && io->out_len)
 	{
-		write(1, buf, count);
-		count = 0;
+		COUNT_SYSCALL(SC_WRITE);
+		write(1, io->out_buf, io->out_len);
+		io->out_len = 0;
 	}
 
 	if (c != BUF_FLUSH)
-		buf[count++] = c;
+		io->out_buf[io->out_len++] = c;
 
 	return (1);
 }
@@ -0,0 +1,91 @@
+#include "main.h"
+
+/**
+ * set_cmd_string - Sets up the shell to run a "-c" command string.
+ * @info_struct: Pointer to the info_t structure.
+ * @arg_c: The number of command-line arguments.
+ * @arg_v: The command-line arguments ("hsh -c 'cmd' [arg0 args...]").
+ *
+ * Description: The command string is parsed straight from memory instead of
+ * a file descriptor. When arg0 is given it becomes $0 and the name used in
+ * error messages, and the arguments after it become $1..$N.
+ *
+ * Return: The offset of the new program name within @arg_v.
+ */
+int set_cmd_string(info_t *info_struct, int arg_c, char **arg_v)
+{
+	if (arg_c < 3)
+	{
+		print_string(arg_v[0]);
+		print_string(": 0: -c requires an argument\n");
+		print_char(BUF_FLUSH);
+		exit(2);
+	}
+
+	info_struct->cmd_str = arg_v[2];
+	if (arg_c == 3)
+		return (0);
+
+	info_struct->fname = arg_v[3];
+	info_struct->pos_argv = arg_v + 3;
+	info_struct->pos_argc = arg_c - 3;
+	return (3);
+}
+
+/**
+ * get_string_line - Takes the next line from the "-c" command string.
+ * @info_struct: Pointer to the info_t structure.
+ * @ptr_address: Where to store the newly allocated line.
+ * @length: Where to store the length of the line, may be NULL.
+ *
+ * Description: This function is the in-memory counterpart of
+ * get_stdin_line(). It copies the text up to and including the next
+ * newline and advances the command string past it. No system call is made.
+ *
+ * Return: The length of the line, or -1 once the string is exhausted.
+ */
+int get_string_line(info_t *info_struct, char **ptr_address, size_t *length)
+{
+	char *start = info_struct->cmd_str, *end, *line;
+	int len;
+
+	if (!start || !*start)
+		return (-1);
+
+	end = _strchr(start, '\n');
+	len = end ? end - start + 1 : _strlen(start);
+	line = malloc(len + 1);
+	if (!line)
+		return (-1);
+	_strncpy(line, start, len + 1);
+	info_struct->cmd_str = start + len;
+
+	free(*ptr_address);
+	*ptr_address = line;
+	if (length)
+		*length = len;
+	return (len);
+}
+
+/**
+ * read_input_line - Reads the next input line from the active source.
+ * @info_struct: Pointer to the info_t structure.
+ * @ptr_address: Pointer to the address of the line buffer.
+ * @length: Pointer to the length of the line buffer.
+ *
+ * Return: The length of the line, or -1 on end of input or failure.
+ */
+int read_input_line(info_t *info_struct, char **ptr_address, size_t *length)
+{
+	int read_len;
+
+	if (info_struct->cmd_str)
+		read_len = get_string_line(info_struct, ptr_address, length);
+	else if (is_interactive(info_struct) && info_struct->readfd == 0)
+		read_len = edit_line(info_struct, ptr_address, length);
+	else
+		read_len = get_stdin_line(info_struct, ptr_address, length);
+	if (read_len > 0)
+		info_struct->src_line++;
+	return (read_len);
+}
@@ -0,0 +1,87 @@
+#include "main.h"
+
+/**
+ * syscall_counts - Returns the per-syscall counters.
+ *
+ * Description: Every system call site in the shell bumps its counter
+ * through COUNT_SYSCALL(). Many of those sites have no info_t at hand, so
+ * the counters are those of the current interpreter (shell_ctx()), kept
+ * alongside its output buffers. Interpreters running on other threads
+ * count apart and never share a counter.
+ *
+ * Return: The array of SC_MAX counters, indexed by SC_* id.
+ */
+unsigned long *syscall_counts(void)
+{
+	return (shell_ctx()->io.syscalls);
+}
+
+/**
+ * report_syscall_stats - Prints syscall counts per executed command.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The counters are copied before anything is printed, so the
+ * write() made by the report itself is not part of it. The output goes to
+ * standard error.
+ */
+void report_syscall_stats(info_t *info_struct)
+{
+	char *names[] = {"read", "write", "open", "close", "stat", "fstat",
+		"lseek", "isatty", "fork", "execve", "wait", "getpid", "sigaction",
+		"chdir", "getcwd", "socket", "dup", "event", "kill", "tty"};
+	unsigned long counts[SC_MAX], total = 0, per_cmd = 0;
+	int id;
+
+	for (id = 0; id < SC_MAX; id++)
+		total += (counts[id] = syscall_counts()[id]);
+	if (info_struct->cmd_count)
+		per_cmd = total * 100 / info_struct->cmd_count;
+
+	print_string(info_struct->fname);
+	print_string(": syscalls: ");
+	print_string(num_str_converter(total, 10, 0));
+	print_string(" total, ");
+	print_string(num_str_converter(info_struct->cmd_count, 10, 0));
+	print_string(" commands, ");
+	print_string(num_str_converter(per_cmd / 100, 10, 0));
+	print_char('.');
+	print_char('0' + per_cmd % 100 / 10);
+	print_char('0' + per_cmd % 10);
+	print_string(" per command\n");
+	for (id = 0; id < SC_MAX; id++)
+	{
+		if (!counts[id])
+			continue;
+		print_string("  ");
+		print_string(names[id]);
+		print_char(' ');
+		print_string(num_str_converter(counts[id], 10, 0));
+		print_char('\n');
+	}
+	print_char(BUF_FLUSH);
+}
+
+/**
+ * report_stats - Emits the reports requested on the command line.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: This function is called once when the shell is about to
+ * exit, or just before it replaces itself with exec.
+ */
+void report_stats(info_t *info_struct)
+{
+	if (info_struct->syscall_stats)
+		report_syscall_stats(info_struct);
+	if (info_struct->phases)
+	{
+		write_stats_json(info_struct);
+		free_ptr((void **)&info_struct->phases);
+	}
+	if (info_struct->profile_file)
+		write_profile(info_struct);
+	if (info_struct->trace)
+	{
+		write_trace(info_struct);
+		free_ptr((void **)&info_struct->trace);
+	}
+}
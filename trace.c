@@ -0,0 +1,121 @@
+#include "main.h"
+
+/**
+ * init_trace - Allocates the trace ring buffer if tracing was requested.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The dump file comes from --trace, or else from the HSH_TRACE
+ * environment variable. Once the buffer exists, SIGUSR1 dumps it on demand.
+ * The last command is forked rather than exec'd in place, so that it is
+ * recorded too.
+ *
+ * Return: 0 on success, 1 on memory allocation failure.
+ */
+int init_trace(info_t *info_struct)
+{
+	struct sigaction action;
+
+	if (!info_struct->trace_file)
+		info_struct->trace_file = get_env_var(info_struct, "HSH_TRACE=");
+	if (!info_struct->trace_file)
+		return (0);
+
+	info_struct->trace = malloc(sizeof(trace_rec_t) * TRACE_RING_SIZE);
+	if (!info_struct->trace)
+		return (1);
+	trace_owner(info_struct);
+	info_struct->keep_shell++;
+
+	_memset((char *)&action, 0, sizeof(action));
+	action.sa_handler = sigusr1_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	COUNT_SYSCALL(SC_SIGACTION);
+	sigaction(SIGUSR1, &action, NULL);
+	return (0);
+}
+
+/**
+ * trace_hash - Hashes a command name for a trace record.
+ * @name: The command name.
+ *
+ * Return: The 32-bit djb2 hash of @name.
+ */
+unsigned int trace_hash(char *name)
+{
+	unsigned int hash = 5381;
+
+	while (*name)
+		hash = ((hash << 5) + hash) + (unsigned char)*name++;
+	return (hash);
+}
+
+/**
+ * trace_record - Appends a finished command to the trace ring buffer.
+ * @info_struct: Pointer to the info_t structure.
+ * @start: Time the command started at, from now_ns().
+ * @line: Input line of the command.
+ * @hash: Hash of the command name, from trace_hash().
+ *
+ * Description: Once the buffer is full the oldest record is overwritten.
+ * Recording is a clock read and a handful of stores, with no system call.
+ */
+void trace_record(info_t *info_struct, unsigned long start, unsigned int line,
+		unsigned int hash)
+{
+	trace_rec_t *rec;
+
+	rec = &info_struct->trace[info_struct->trace_count % TRACE_RING_SIZE];
+	rec->start_ns = start;
+	rec->dur_ns = now_ns() - start;
+	rec->line = line;
+	rec->name_hash = hash;
+	rec->pid = info_struct->child_pid ? info_struct->child_pid
+		: shell_pid(info_struct);
+	rec->status = info_struct->status;
+	info_struct->trace_count++;
+}
+
+/**
+ * write_trace - Dumps the trace ring buffer to the trace file.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: The dump is the 8-byte TRACE_MAGIC, the number of records
+ * as an unsigned long, then the records from oldest to newest, all in host
+ * byte order. Only open(), write() and close() are used, so this is safe
+ * to call from the SIGUSR1 handler.
+ *
+ * Return: 1 on success, -1 on failure.
+ */
+int write_trace(info_t *info_struct)
+{
+	unsigned long count = info_struct->trace_count, first = 0;
+	int file_desc;
+
+	if (count > TRACE_RING_SIZE)
+	{
+		first = count % TRACE_RING_SIZE;
+		count = TRACE_RING_SIZE;
+	}
+	COUNT_SYSCALL(SC_OPEN);
+	file_desc = open(info_struct->trace_file, O_CREAT | O_TRUNC | O_WRONLY,
+			0644);
+	if (file_desc == -1)
+		return (-1);
+
+	COUNT_SYSCALL(SC_WRITE);
+	write(file_desc, TRACE_MAGIC, 8);
+	COUNT_SYSCALL(SC_WRITE);
+	write(file_desc, &count, sizeof(count));
+	COUNT_SYSCALL(SC_WRITE);
+	write(file_desc, info_struct->trace + first,
+			sizeof(trace_rec_t) * (count - first));
+	if (first)
+	{
+		COUNT_SYSCALL(SC_WRITE);
+		write(file_desc, info_struct->trace, sizeof(trace_rec_t) * first);
+	}
+	COUNT_SYSCALL(SC_CLOSE);
+	close(file_desc);
+	return (1);
+}
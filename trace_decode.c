@@ -0,0 +1,77 @@
+#include "main.h"
+
+/**
+ * decode_trace - Prints a trace dump written by write_trace().
+ * @info_struct: Pointer to the info_t structure, for error messages.
+ * @path: Path of the dump.
+ *
+ * Description: This function handles "hsh --decode-trace FILE". Each record
+ * is printed on one line, with its start time relative to the first one.
+ *
+ * Return: 0 on success, 2 if the file cannot be read or is not a dump.
+ */
+int decode_trace(info_t *info_struct, char *path)
+{
+	char magic[8];
+	unsigned long count, index, base = 0;
+	trace_rec_t rec;
+	int file_desc;
+
+	COUNT_SYSCALL(SC_OPEN);
+	file_desc = open(path, O_RDONLY);
+	if (file_desc == -1
+			|| read(file_desc, magic, 8) != 8
+			|| _strcmp(magic, TRACE_MAGIC) != 0
+			|| read(file_desc, &count, sizeof(count)) != sizeof(count))
+	{
+		print_error(info_struct, "Not a trace dump ");
+		print_string(path);
+		print_char('\n');
+		print_char(BUF_FLUSH);
+		return (2);
+	}
+
+	for (index = 0; index < count; index++)
+	{
+		if (read(file_desc, &rec, sizeof(rec)) != sizeof(rec))
+			break;
+		if (!index)
+			base = rec.start_ns;
+		print_trace_rec(&rec, index, base);
+	}
+	_putchar(BUF_FLUSH);
+	COUNT_SYSCALL(SC_CLOSE);
+	close(file_desc);
+	return (0);
+}
+
+/**
+ * print_trace_rec - Prints one trace record.
+ * @rec: The record.
+ * @index: Position of the record in the dump.
+ * @base: Start time of the first record.
+ *
+ * Description: The line reads, for example,
+ * "#3 +1.204 pid=4242 line=7 cmd=1a2b3c4d status=0 dur_us=1520", with the
+ * offset in seconds and the command name as its hash.
+ */
+void print_trace_rec(trace_rec_t *rec, unsigned long index, unsigned long base)
+{
+	char buffer[32];
+
+	_putchar('#');
+	_puts(num_str_converter(index, 10, 0));
+	_puts(" +");
+	_puts(format_usec(buffer, (rec->start_ns - base) / 1000));
+	_puts(" pid=");
+	_puts(num_str_converter(rec->pid, 10, 0));
+	_puts(" line=");
+	_puts(num_str_converter(rec->line, 10, 0));
+	_puts(" cmd=");
+	_puts(num_str_converter(rec->name_hash, 16, CONVERT_LOWERCASE));
+	_puts(" status=");
+	_puts(num_str_converter(rec->status, 10, 0));
+	_puts(" dur_us=");
+	_puts(num_str_converter(rec->dur_ns / 1000, 10, 0));
+	_putchar('\n');
+}
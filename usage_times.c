@@ -0,0 +1,152 @@
+#include "main.h"
+
+/**
+ * record_usage - Accounts for the resources used by a reaped child.
+ * @info_struct: Pointer to the info_t structure.
+ * @usage: The rusage reported by wait4() for the child.
+ * @real_ns: Wall-clock time from fork to reap, in nanoseconds.
+ *
+ * Description: The child becomes the last command and is added to the
+ * session totals. The session keeps the largest RSS seen as its maximum.
+ */
+void record_usage(info_t *info_struct, struct rusage *usage,
+		unsigned long real_ns)
+{
+	cmd_usage_t *last = &info_struct->last_usage;
+	cmd_usage_t *total = &info_struct->total_usage;
+
+	last->count = 1;
+	last->real_ns = real_ns;
+	last->user_us = TV_US(usage->ru_utime);
+	last->sys_us = TV_US(usage->ru_stime);
+	last->maxrss_kb = usage->ru_maxrss;
+
+	total->count++;
+	total->real_ns += last->real_ns;
+	total->user_us += last->user_us;
+	total->sys_us += last->sys_us;
+	if (last->maxrss_kb > total->maxrss_kb)
+		total->maxrss_kb = last->maxrss_kb;
+}
+
+/**
+ * format_usec - Formats a duration as seconds with millisecond precision.
+ * @buffer: Destination, at least 32 bytes.
+ * @usec: The duration in microseconds.
+ *
+ * Return: @buffer, holding e.g. "1.250".
+ */
+char *format_usec(char *buffer, unsigned long usec)
+{
+	unsigned long msec = (usec + 500) / 1000;
+	int len;
+
+	_strcpy(buffer, num_str_converter(msec / 1000, 10, 0));
+	len = _strlen(buffer);
+	buffer[len++] = '.';
+	buffer[len++] = '0' + msec % 1000 / 100;
+	buffer[len++] = '0' + msec % 100 / 10;
+	buffer[len++] = '0' + msec % 10;
+	buffer[len] = '\0';
+	return (buffer);
+}
+
+/**
+ * print_usage - Prints a resource usage line.
+ * @prefix: Text printed before the figures.
+ * @usage: The usage to print; the real time is omitted if @usage counts
+ * no command.
+ * @file_desc: STDERR_FILENO for standard error, standard output otherwise.
+ */
+void print_usage(char *prefix, cmd_usage_t *usage, int file_desc)
+{
+	void (*out)(char *) = _puts;
+	char buffer[32];
+
+	if (file_desc == STDERR_FILENO)
+		out = print_string;
+
+	out(prefix);
+	if (usage->count)
+	{
+		out("real ");
+		out(format_usec(buffer, usage->real_ns / 1000));
+		out(" ");
+	}
+	out("user ");
+	out(format_usec(buffer, usage->user_us));
+	out(" sys ");
+	out(format_usec(buffer, usage->sys_us));
+	out(" maxrss ");
+	out(num_str_converter(usage->maxrss_kb, 10, 0));
+	out("k\n");
+}
+
+/**
+ * hsh_time - Handles the time keyword.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: -2 if the timed command asked the shell to exit, 0 otherwise.
+ *
+ * Description: This function runs the rest of the command line and prints
+ * its wall, user and sys time and max RSS to standard error. CPU time
+ * counts both the shell itself (builtins, functions) and the children
+ * reaped meanwhile. The figures also become the last command's usage.
+ */
+int hsh_time(info_t *info_struct)
+{
+	cmd_usage_t before = info_struct->total_usage, span;
+	struct rusage self_before, self_after;
+	unsigned long start = now_ns();
+	int result = 0;
+
+	getrusage(RUSAGE_SELF, &self_before);
+	if (info_struct->argc > 1)
+	{
+		info_struct->keep_shell++;
+		result = dispatch_rest(info_struct, 1);
+		info_struct->keep_shell--;
+	}
+	getrusage(RUSAGE_SELF, &self_after);
+
+	span.count = 1;
+	span.real_ns = now_ns() - start;
+	span.user_us = TV_US(self_after.ru_utime) - TV_US(self_before.ru_utime)
+		+ info_struct->total_usage.user_us - before.user_us;
+	span.sys_us = TV_US(self_after.ru_stime) - TV_US(self_before.ru_stime)
+		+ info_struct->total_usage.sys_us - before.sys_us;
+	span.maxrss_kb = info_struct->total_usage.count != before.count
+		? info_struct->last_usage.maxrss_kb : self_after.ru_maxrss;
+	info_struct->last_usage = span;
+	print_usage("", &span, STDERR_FILENO);
+	return (result == -2 ? -2 : 0);
+}
+
+/**
+ * hsh_times - Handles the times builtin.
+ * @info_struct: Pointer to the info structure.
+ *
+ * Return: Always returns 0.
+ *
+ * Description: This function prints the CPU time and max RSS of the shell
+ * itself. It then prints the number of external commands run this
+ * session, with their accumulated wall, user and sys time and the
+ * largest RSS any of them reached.
+ */
+int hsh_times(info_t *info_struct)
+{
+	struct rusage self;
+	cmd_usage_t shell;
+
+	getrusage(RUSAGE_SELF, &self);
+	_memset((void *)&shell, 0, sizeof(shell));
+	shell.user_us = TV_US(self.ru_utime);
+	shell.sys_us = TV_US(self.ru_stime);
+	shell.maxrss_kb = self.ru_maxrss;
+	print_usage("shell: ", &shell, STDOUT_FILENO);
+
+	_puts("commands: ");
+	_puts(num_str_converter(info_struct->total_usage.count, 10, 0));
+	print_usage(" ", &info_struct->total_usage, STDOUT_FILENO);
+	return (0);
+}
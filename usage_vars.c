@@ -0,0 +1,90 @@
+#include "main.h"
+
+/**
+ * usage_var_value - Looks up a resource usage variable.
+ * @info_struct: Pointer to the info_t structure.
+ * @name: Variable name, without the '$'.
+ * @buffer: Scratch space of at least 32 bytes for the value.
+ *
+ * Description: HSH_REAL, HSH_USER and HSH_SYS (seconds) and HSH_MAXRSS
+ * (kilobytes) describe the last external or timed command. The same names
+ * with a HSH_TOTAL_ prefix give the session totals, and HSH_TOTAL_COUNT
+ * the number of external commands run.
+ *
+ * Return: The value, or NULL if @name is not a usage variable.
+ */
+char *usage_var_value(info_t *info_struct, char *name, char *buffer)
+{
+	cmd_usage_t *usage = &info_struct->last_usage;
+	char *field = starts_with(name, "HSH_");
+
+	if (!field)
+		return (NULL);
+	if (starts_with(field, "TOTAL_"))
+	{
+		usage = &info_struct->total_usage;
+		field += 6;
+		if (_strcmp(field, "COUNT") == 0)
+			return (_strcpy(buffer, num_str_converter(usage->count, 10, 0)));
+	}
+
+	if (_strcmp(field, "REAL") == 0)
+		return (format_usec(buffer, usage->real_ns / 1000));
+	if (_strcmp(field, "USER") == 0)
+		return (format_usec(buffer, usage->user_us));
+	if (_strcmp(field, "SYS") == 0)
+		return (format_usec(buffer, usage->sys_us));
+	if (_strcmp(field, "MAXRSS") == 0)
+		return (_strcpy(buffer, num_str_converter(usage->maxrss_kb, 10, 0)));
+	return (NULL);
+}
+
+/**
+ * replace_usage_var - Expands a resource usage variable in an argument.
+ * @info_struct: Pointer to the info_t structure.
+ * @count: Index of the argument to expand.
+ *
+ * Return: 1 if the argument was expanded, 0 if it is not a usage variable.
+ */
+int replace_usage_var(info_t *info_struct, int count)
+{
+	char buffer[32], *value;
+
+	value = usage_var_value(info_struct, info_struct->argv[count] + 1, buffer);
+	if (!value)
+		return (0);
+
+	return (replace_string(&(info_struct->argv[count]), _strdup(value)));
+}
+
+/**
+ * replace_env_var - Expands an environment variable in an argument.
+ * @info_struct: Pointer to the info_t structure.
+ * @count: Index of the argument to expand.
+ *
+ * Description: The name ends at the first character that is not a
+ * letter, digit or '_', and the text after it is kept, so "$dir/x"
+ * becomes the value of dir followed by "/x". An unset variable expands
+ * to nothing; a '$' followed by no name is left as it is.
+ *
+ * Return: Always 1.
+ */
+int replace_env_var(info_t *info_struct, int count)
+{
+	char *arg = info_struct->argv[count], *rest = arg + 1, *value, *str, save;
+	info_list *node;
+
+	while (is_alpha(*rest) || (*rest >= '0' && *rest <= '9') || *rest == '_')
+		rest++;
+	if (rest == arg + 1)
+		return (1);
+	save = *rest;
+	*rest = '\0';
+	node = node_starts_with(get_env_list(info_struct), arg + 1, '=');
+	*rest = save;
+	value = node ? _strchr(node->str, '=') + 1 : "";
+	str = malloc(_strlen(value) + _strlen(rest) + 1);
+	if (str)
+		_strcat(_strcpy(str, value), rest);
+	return (replace_string(&info_struct->argv[count], str));
+}
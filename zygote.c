@@ -0,0 +1,166 @@
+#include "main.h"
+
+/**
+ * start_zygote - Forks the spawn helper requested by --zygote.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Description: fork() copies the page tables of the process that calls
+ * it, so its cost grows with the shell's history, aliases and environment.
+ * The zygote is forked before any of those are loaded and forks every
+ * external command on the shell's behalf, so spawning stays as cheap as
+ * it is at startup. Without a zygote, commands are forked by the shell.
+ */
+void start_zygote(info_t *info_struct)
+{
+	int pair[2];
+	pid_t pid;
+
+	if (!info_struct->zygote)
+		return;
+	COUNT_SYSCALL(SC_SOCKET);
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == -1)
+		return;
+	COUNT_SYSCALL(SC_FORK);
+	pid = fork();
+	if (pid == 0)
+	{
+		close(pair[0]);
+		zygote_loop(pair[1]);
+	}
+	COUNT_SYSCALL(SC_CLOSE);
+	close(pair[1]);
+	if (pid == -1)
+	{
+		close(pair[0]);
+		return;
+	}
+	info_struct->zygote_fd = pair[0];
+	info_struct->zygote_pid = pid;
+}
+
+/**
+ * zygote_loop - Main loop of the zygote.
+ * @sock: The zygote's end of the socket pair.
+ *
+ * Description: SIGCHLD stays blocked except inside pselect(), so a child
+ * that exits is always reaped, and reported, before the next wait. SIGINT
+ * and SIGQUIT from the terminal are ignored, as they are meant for the
+ * foreground command. The zygote exits once the shell closes its end.
+ */
+void zygote_loop(int sock)
+{
+	struct sigaction action;
+	sigset_t chld, orig;
+	fd_set readable;
+
+	_memset((char *)&action, 0, sizeof(action));
+	action.sa_handler = catch_signal;
+	sigaction(SIGCHLD, &action, NULL);
+	action.sa_handler = SIG_IGN;
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGQUIT, &action, NULL);
+	sigemptyset(&chld);
+	sigaddset(&chld, SIGCHLD);
+	sigprocmask(SIG_BLOCK, &chld, &orig);
+	while (1)
+	{
+		zygote_reap(sock);
+		FD_ZERO(&readable);
+		FD_SET(sock, &readable);
+		if (pselect(sock + 1, &readable, NULL, NULL, NULL, &orig) == 1
+				&& zygote_spawn(sock, &orig) == -1)
+			_exit(0);
+	}
+}
+
+/**
+ * zygote_spawn - Forks the command of one spawn request.
+ * @sock: The zygote's end of the socket pair.
+ * @orig: Signal mask to restore in the child.
+ *
+ * Description: The fork is reported right away with ZYG_SPAWNED; its exit
+ * status follows later from zygote_reap().
+ *
+ * Return: 0 on success, -1 once the shell is gone.
+ */
+int zygote_spawn(int sock, sigset_t *orig)
+{
+	zygote_req_t req;
+	zygote_msg_t msg;
+	int fds[3], index;
+	size_t size;
+	char *payload;
+
+	if (recv_fds(sock, &req, sizeof(req), fds) == -1)
+		return (-1);
+	size = (size_t)req.argv_len + req.env_len + req.cwd_len;
+	payload = malloc(size + 1);
+	if (!payload || read_full(sock, payload, size) == -1)
+	{
+		for (index = 0; index < 3; index++)
+			close(fds[index]);
+		free(payload);
+		return (-1);
+	}
+	payload[size] = '\0';
+	_memset((char *)&msg, 0, sizeof(msg));
+	msg.kind = ZYG_SPAWNED;
+	msg.pid = fork();
+	if (msg.pid == 0)
+		zygote_exec(payload, &req, fds, orig);
+	if (msg.pid == -1)
+		msg.status = errno;
+	for (index = 0; index < 3; index++)
+		close(fds[index]);
+	free(payload);
+	return (write_full(sock, (char *)&msg, sizeof(msg)));
+}
+
+/**
+ * zygote_exec - Executes a spawn request in a child of the zygote.
+ * @payload: The path, arguments, environment and directory of the request.
+ * @req: The request header.
+ * @fds: The shell's stdin, stdout and stderr.
+ * @orig: Signal mask to restore.
+ *
+ * Description: Fails like a child of fork_child(), through exec_failed(),
+ * if execve() fails. The zygote was forked from the shell, so it still
+ * holds the shell's info_t.
+ */
+void zygote_exec(char *payload, zygote_req_t *req, int *fds, sigset_t *orig)
+{
+	struct sigaction action;
+	char **argv, **envp;
+	int index;
+
+	_memset((char *)&action, 0, sizeof(action));
+	action.sa_handler = SIG_DFL;
+	sigaction(SIGCHLD, &action, NULL);
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGQUIT, &action, NULL);
+	sigprocmask(SIG_SETMASK, orig, NULL);
+	for (index = 0; index < 3; index++)
+		dup2(fds[index], index);
+	if (req->cwd_len && chdir(payload + req->argv_len + req->env_len) == -1)
+		_exit(1);
+	argv = split_block(payload, req->argv_len);
+	envp = split_block(payload + req->argv_len, req->env_len);
+	if (argv && envp && argv[0])
+		execve(argv[0], argv + 1, envp);
+	shell_ctx()->line_count = req->line; /* a copy of the shell's */
+	exec_failed(shell_ctx(), argv && argv[1] ? argv[1] : payload);
+}
+
+/**
+ * zygote_reap - Reports every child of the zygote that has exited.
+ * @sock: The zygote's end of the socket pair.
+ */
+void zygote_reap(int sock)
+{
+	zygote_msg_t msg;
+
+	_memset((char *)&msg, 0, sizeof(msg));
+	msg.kind = ZYG_EXITED;
+	while ((msg.pid = wait4(-1, &msg.status, WNOHANG, &msg.usage)) > 0)
+		write_full(sock, (char *)&msg, sizeof(msg));
+}
@@ -0,0 +1,145 @@
+#include "main.h"
+
+/**
+ * zygote_run - Runs the current command through the zygote.
+ * @info_struct: Pointer to the info_t structure.
+ * @usage: Where to store the resource usage of the command.
+ *
+ * Description: Messages for other children are skipped. A zygote that has
+ * gone away is dropped, and the shell forks commands itself from then on;
+ * a command it had started is left to zygote_lost().
+ *
+ * Return: The process id of the command, with its wait status in
+ * info_struct->status, or -1 if the command was not run.
+ */
+pid_t zygote_run(info_t *info_struct, struct rusage *usage)
+{
+	zygote_msg_t msg;
+	pid_t pid = -1;
+
+	if (!info_struct->zygote_pid || zygote_send(info_struct) == -1)
+		pid = -2;
+	while (pid != -2 && read_full(info_struct->zygote_fd, (char *)&msg,
+				sizeof(msg)) == 0)
+	{
+		if (msg.kind == ZYG_SPAWNED && msg.pid == -1)
+			return (-1);
+		if (msg.kind == ZYG_SPAWNED)
+		{
+			pid = msg.pid;
+			USDT_PROBE2(spawn, info_struct->path, pid);
+		}
+		else if (msg.kind == ZYG_EXITED && msg.pid == pid)
+		{
+			info_struct->status = msg.status;
+			*usage = msg.usage;
+			return (pid);
+		}
+	}
+	if (info_struct->zygote_pid)
+	{
+		COUNT_SYSCALL(SC_CLOSE);
+		close(info_struct->zygote_fd);
+		COUNT_SYSCALL(SC_WAIT);
+		waitpid(info_struct->zygote_pid, NULL, WNOHANG);
+		info_struct->zygote_pid = 0;
+	}
+	if (pid < 0)
+		return (-1);
+	zygote_lost(info_struct, pid);
+	_memset((char *)usage, 0, sizeof(*usage));
+	return (pid);
+}
+
+/**
+ * zygote_lost - Finishes a command whose zygote went away.
+ * @info_struct: Pointer to the info_t structure.
+ * @pid: The command, reported started by the zygote.
+ *
+ * Description: The command is now a child of init, so its exit status is
+ * lost, but it may well still be running. Where the kernel has pidfds the
+ * shell waits for it to exit before going on, as it would have. The loss
+ * is reported and the command gets status 2, as a shell error would.
+ */
+void zygote_lost(info_t *info_struct, pid_t pid)
+{
+	struct pollfd fds;
+
+	fds.fd = -1;
+	fds.events = POLLIN;
+#ifdef SYS_pidfd_open
+	COUNT_SYSCALL(SC_EVENT);
+	fds.fd = syscall(SYS_pidfd_open, pid, 0);
+#endif
+	if (fds.fd != -1)
+	{
+		do {
+			COUNT_SYSCALL(SC_EVENT);
+		} while (poll(&fds, 1, -1) == -1 && errno == EINTR);
+		COUNT_SYSCALL(SC_CLOSE);
+		close(fds.fd);
+	}
+	print_error(info_struct, "exit status lost: the zygote went away\n");
+	info_struct->status = W_EXITCODE(2, 0);
+}
+
+/**
+ * zygote_send - Sends the current command to the zygote.
+ * @info_struct: Pointer to the info_t structure.
+ *
+ * Return: 0 on success, -1 on error.
+ */
+int zygote_send(info_t *info_struct)
+{
+	zygote_req_t req;
+	char **env = get_environ(info_struct), cwd[PATH_MAX], *payload, *pos;
+	int index, result;
+
+	req.line = info_struct->line_count;
+	req.argv_len = _strlen(info_struct->path) + 1;
+	for (index = 0; info_struct->argv[index]; index++)
+		req.argv_len += _strlen(info_struct->argv[index]) + 1;
+	for (req.env_len = 0, index = 0; env[index]; index++)
+		req.env_len += _strlen(env[index]) + 1;
+	COUNT_SYSCALL(SC_GETCWD);
+	req.cwd_len = getcwd(cwd, sizeof(cwd)) ? _strlen(cwd) + 1 : 0;
+	payload = malloc((size_t)req.argv_len + req.env_len + req.cwd_len);
+	if (!payload)
+		return (-1);
+	pos = payload + _strlen(_strcpy(payload, info_struct->path)) + 1;
+	for (index = 0; info_struct->argv[index]; index++)
+		pos += _strlen(_strcpy(pos, info_struct->argv[index])) + 1;
+	for (index = 0; env[index]; index++)
+		pos += _strlen(_strcpy(pos, env[index])) + 1;
+	if (req.cwd_len)
+		_strcpy(pos, cwd);
+	result = send_fds(info_struct->zygote_fd, &req, sizeof(req));
+	if (result == 0)
+		result = write_full(info_struct->zygote_fd, payload,
+				(size_t)req.argv_len + req.env_len + req.cwd_len);
+	free(payload);
+	return (result);
+}
+
+/**
+ * split_block - Splits a block of '\0'-terminated strings into an array.
+ * @block: The strings, one after another.
+ * @len: Length of @block.
+ *
+ * Return: A malloc'd NULL-terminated array pointing into @block, or NULL.
+ */
+char **split_block(char *block, unsigned int len)
+{
+	unsigned int pos, count = 0, total = 0;
+	char **strs;
+
+	for (pos = 0; pos < len; pos++)
+		total += !block[pos];
+	strs = malloc(sizeof(char *) * (total + 1));
+	if (!strs)
+		return (NULL);
+	for (pos = 0; pos < len && count < total; pos += _strlen(block + pos) + 1)
+		strs[count++] = block + pos;
+	strs[count] = NULL;
+	return (strs);
+}